@@ -0,0 +1,333 @@
+/**
+ * Opakovatelna mereni hlavnich funkci crawleru nad korpusem HTML stranek (bench/corpus):
+ * analyzeHtml, otisky pro hledani duplicit (simHash), normalizeUrl, getBaseUrl, urlToSafeFilename a zapis map.txt a content.txt (createWebGraph,
+ * createContent - v crawleru jen volaji writeWebGraph a writeContent s ResultWriterThreads vlakny).
+ *
+ * Vzorek je jeden pruchod vsemi vstupy mereni (stranky korpusu, URL z jejich odkazu, ulozene vysledky);
+ * z casu vzorku na operaci se pocita prumer a percentily. Alokace se pocitaji nahrazenym globalnim operator new
+ * behem merenych vzorku. Vystup analyzy na std::cout se behem mereni zahazuje.
+ * Vysledky se vypisou jako tabulka a ulozi jako JSON pro porovnani behu.
+ *
+ * Pouziti: crawler_bench [adresar korpusu] [vystupni JSON] [pocet vzorku]
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include "../src/page_analyzer.h"
+#include "../src/url_resolver.h"
+#include "../src/result_writer.h"
+#include "../src/duplicate_index.h"
+
+#ifndef CRAWLER_BENCH_CORPUS
+#define CRAWLER_BENCH_CORPUS "bench/corpus"
+#endif
+
+namespace {
+    // alokace behem merenych vzorku; zapis vysledku alokuje i ve formatovacich vlaknech
+    std::atomic<size_t> g_allocations{ 0 };
+    std::atomic<size_t> g_allocatedBytes{ 0 };
+
+    // vysledky merenych funkci se scitaji sem, aby je prekladac nevynechal
+    volatile size_t g_sink = 0;
+
+    // pocet kopii stranek korpusu v ulozisti pro mereni zapisu vysledku
+    constexpr size_t WriterPages = 20000;
+    // na kolik stranek ulozene kopie navic odkazuji (hrany grafu mezi obchazenymi strankami)
+    constexpr size_t WriterLinksPerPage = 5;
+
+    struct CorpusPage {
+        std::string file;
+        std::string url;
+        std::string html;
+    };
+
+    struct BenchResult {
+        std::string name;
+        // co je jedna operace - stranka, URL, zapsana stranka
+        std::string unit;
+        size_t opsPerSample = 0;
+        // vstupni (analyza) nebo vystupni (zapis) bajty jednoho vzorku; 0 = propustnost v bajtech nema smysl
+        size_t bytesPerSample = 0;
+        // cas jedne operace v kazdem vzorku
+        std::vector<double> nsPerOp;
+        double allocationsPerOp = 0;
+        double allocatedBytesPerOp = 0;
+    };
+
+    // zahodi vse, co do nej analyza vypise
+    class CNullBuffer : public std::streambuf {
+        protected:
+            int overflow(int c) override { return traits_type::not_eof(c); }
+            std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size ? size : 1);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return block;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+// nacte stranky podle corpus.txt (radky "soubor URL", # uvozuje komentar)
+static std::vector<CorpusPage> loadCorpus(const std::filesystem::path& dir) {
+    std::vector<CorpusPage> pages;
+    std::ifstream list(dir / "corpus.txt");
+    std::string line;
+    while (std::getline(list, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        CorpusPage page;
+        fields >> page.file >> page.url;
+        std::ifstream file(dir / page.file, std::ios::binary);
+        if (!file) {
+            std::cerr << "Nelze otevrit " << (dir / page.file).string() << std::endl;
+            continue;
+        }
+        page.html.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        pages.push_back(std::move(page));
+    }
+    return pages;
+}
+
+// nearest-rank percentil serazenych hodnot
+static double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.999999);
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+// pass - jeden pruchod vsemi vstupy (opsPerSample operaci); prvni pruchod se nemeri (zahrati cache a alokatoru)
+static BenchResult runBench(const std::string& name, const std::string& unit, size_t opsPerSample, size_t bytesPerSample,
+                            size_t samples, const std::function<void()>& pass) {
+    BenchResult result{ name, unit, opsPerSample, bytesPerSample, {}, 0, 0 };
+    pass();
+
+    size_t allocationsBefore = g_allocations.load();
+    size_t bytesBefore = g_allocatedBytes.load();
+    for (size_t i = 0; i < samples; i++) {
+        auto start = std::chrono::steady_clock::now();
+        pass();
+        auto end = std::chrono::steady_clock::now();
+        result.nsPerOp.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(opsPerSample));
+    }
+    double ops = static_cast<double>(samples * opsPerSample);
+    result.allocationsPerOp = static_cast<double>(g_allocations.load() - allocationsBefore) / ops;
+    result.allocatedBytesPerOp = static_cast<double>(g_allocatedBytes.load() - bytesBefore) / ops;
+    return result;
+}
+
+static double mean(const std::vector<double>& values) {
+    double sum = 0;
+    for (double value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0 : sum / static_cast<double>(values.size());
+}
+
+static void printTable(const std::vector<BenchResult>& results) {
+    std::cout << std::left << std::setw(44) << "benchmark" << std::right << std::setw(12) << "p50 [ns]" << std::setw(12) << "p90 [ns]"
+              << std::setw(12) << "p99 [ns]" << std::setw(14) << "ops/s" << std::setw(10) << "MB/s" << std::setw(12) << "allocs/op"
+              << std::setw(14) << "B alloc/op" << std::endl;
+    for (const BenchResult& result : results) {
+        std::vector<double> sorted = result.nsPerOp;
+        std::sort(sorted.begin(), sorted.end());
+        double nsPerOp = mean(result.nsPerOp);
+        double megabytesPerSecond = result.bytesPerSample == 0 ? 0
+            : static_cast<double>(result.bytesPerSample) / (nsPerOp * static_cast<double>(result.opsPerSample)) * 1e9 / 1e6;
+
+        std::cout << std::left << std::setw(44) << result.name + " [" + result.unit + "]" << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << percentile(sorted, 50) << std::setw(12) << percentile(sorted, 90) << std::setw(12) << percentile(sorted, 99)
+                  << std::setw(14) << 1e9 / nsPerOp << std::setprecision(1) << std::setw(10) << megabytesPerSecond
+                  << std::setw(12) << result.allocationsPerOp << std::setprecision(0) << std::setw(14) << result.allocatedBytesPerOp << std::endl;
+    }
+}
+
+static std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+static void writeJson(const std::string& path, const std::vector<BenchResult>& results, const std::vector<CorpusPage>& corpus, size_t corpusBytes) {
+    std::ofstream out(path);
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    out << std::fixed << std::setprecision(1);
+    out << "{\n  \"benchmark\": \"crawler_bench\",\n  \"timestamp\": \"" << timestamp << "\",\n  \"compiler\": \"" << compilerName()
+        << "\",\n  \"build\": \"" << build << "\",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ",\n  \"corpus\": { \"pages\": " << corpus.size() << ", \"bytes\": " << corpusBytes << " },\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        std::vector<double> sorted = result.nsPerOp;
+        std::sort(sorted.begin(), sorted.end());
+        double nsPerOp = mean(result.nsPerOp);
+
+        out << "    { \"name\": \"" << result.name << "\", \"unit\": \"" << result.unit << "\", \"ops_per_sample\": " << result.opsPerSample
+            << ", \"samples\": " << result.nsPerOp.size() << ", \"mean_ns\": " << nsPerOp << ", \"min_ns\": " << sorted.front()
+            << ", \"p50_ns\": " << percentile(sorted, 50) << ", \"p90_ns\": " << percentile(sorted, 90) << ", \"p99_ns\": " << percentile(sorted, 99)
+            << ", \"max_ns\": " << sorted.back() << ", \"ops_per_s\": " << 1e9 / nsPerOp;
+        if (result.bytesPerSample != 0) {
+            out << ", \"mb_per_s\": " << static_cast<double>(result.bytesPerSample) / (nsPerOp * static_cast<double>(result.opsPerSample)) * 1e3;
+        }
+        out << std::setprecision(2) << ", \"allocs_per_op\": " << result.allocationsPerOp << std::setprecision(1)
+            << ", \"alloc_bytes_per_op\": " << result.allocatedBytesPerOp << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    std::filesystem::path corpusDir = argc > 1 ? argv[1] : CRAWLER_BENCH_CORPUS;
+    std::string jsonPath = argc > 2 ? argv[2] : "crawler_bench.json";
+    size_t samples = argc > 3 ? std::max<size_t>(1, std::strtoull(argv[3], nullptr, 10)) : 50;
+
+    std::vector<CorpusPage> corpus = loadCorpus(corpusDir);
+    if (corpus.empty()) {
+        std::cerr << "Prazdny korpus v " << corpusDir.string() << " (chybi corpus.txt?)" << std::endl;
+        return 1;
+    }
+    size_t corpusBytes = 0;
+    for (const CorpusPage& page : corpus) {
+        corpusBytes += page.html.size();
+    }
+    std::cout << "Korpus: " << corpus.size() << " stranek, " << corpusBytes << " B" << std::endl;
+
+    // vstupy URL funkci: odkazy stranek korpusu vuci URL stranky a absolutni URL, na ktere vedou
+    std::vector<std::pair<std::string, std::string>> hrefs;
+    std::vector<std::string> absoluteUrls;
+    for (const CorpusPage& page : corpus) {
+        HtmlScanResult scan;
+        scanHtml(page.html, scan);
+        absoluteUrls.push_back(page.url);
+        for (const std::string& href : scan.hrefs) {
+            hrefs.emplace_back(page.url, href);
+            std::string url = normalizeUrl(page.url, href);
+            if (!url.empty()) {
+                absoluteUrls.push_back(std::move(url));
+            }
+        }
+    }
+
+    std::vector<BenchResult> results;
+
+    // analyza vypisuje kazdy odkaz na std::cout - behem mereni se vystup zahazuje
+    CNullBuffer nullBuffer;
+    std::streambuf* console = std::cout.rdbuf(&nullBuffer);
+    for (const CorpusPage& page : corpus) {
+        results.push_back(runBench("analyzeHtml/" + page.file, "page", 1, page.html.size(), samples, [&page] {
+            g_sink = g_sink + analyzeHtml(page.url, page.html).foundUrls.size();
+        }));
+    }
+    results.push_back(runBench("analyzeHtml", "page", corpus.size(), corpusBytes, samples, [&corpus] {
+        for (const CorpusPage& page : corpus) {
+            g_sink = g_sink + analyzeHtml(page.url, page.html).foundUrls.size();
+        }
+    }));
+
+    // crawler pocita otisky jen s hledanim duplicit (analyzePage), analyzeHtml je neobsahuje
+    results.push_back(runBench("simHash", "page", corpus.size(), corpusBytes, samples, [&corpus] {
+        for (const CorpusPage& page : corpus) {
+            g_sink = g_sink + (contentHash(page.html) ^ simHash(page.html));
+        }
+    }));
+
+    // ulozene vysledky pro zapis: kopie analyz stranek korpusu pod vlastni URL, navic s odkazy na dalsi kopie
+    CResultStore store;
+    {
+        std::vector<PageAnalysisResult> analyses;
+        for (const CorpusPage& page : corpus) {
+            analyses.push_back(analyzeHtml(page.url, page.html));
+        }
+        auto copyUrl = [](size_t i) { return "http://bench.test/p/" + std::to_string(i) + ".html"; };
+        for (size_t i = 0; i < WriterPages; i++) {
+            PageAnalysisResult page = analyses[i % analyses.size()];
+            page.url = copyUrl(i);
+            for (size_t k = 1; k <= WriterLinksPerPage; k++) {
+                page.foundUrls.push_back(copyUrl((i * 7 + k * 131) % WriterPages));
+            }
+            store.Add(page.url, page);
+        }
+    }
+    std::cout.rdbuf(console);
+
+    results.push_back(runBench("normalizeUrl", "url", hrefs.size(), 0, samples * 4, [&hrefs] {
+        for (const auto& [base, href] : hrefs) {
+            g_sink = g_sink + normalizeUrl(base, href).size();
+        }
+    }));
+    results.push_back(runBench("getBaseUrl", "url", absoluteUrls.size(), 0, samples * 4, [&absoluteUrls] {
+        for (const std::string& url : absoluteUrls) {
+            g_sink = g_sink + getBaseUrl(url).size();
+        }
+    }));
+    results.push_back(runBench("urlToSafeFilename", "url", absoluteUrls.size(), 0, samples * 4, [&absoluteUrls] {
+        for (const std::string& url : absoluteUrls) {
+            g_sink = g_sink + urlToSafeFilename(url).size();
+        }
+    }));
+
+    // zapis stejne jako createWebGraph a createContent v lokalnich rezimech
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::filesystem::path resultDir = std::filesystem::temp_directory_path() / "crawler_bench";
+    std::filesystem::create_directories(resultDir);
+    size_t writerSamples = std::max<size_t>(3, samples / 5);
+
+    writeWebGraph(resultDir.string(), store, threads);
+    results.push_back(runBench("createWebGraph", "page", store.Size(), std::filesystem::file_size(resultDir / "map.txt"), writerSamples, [&] {
+        g_sink = g_sink + writeWebGraph(resultDir.string(), store, threads);
+    }));
+    writeContent(resultDir.string(), store, threads);
+    results.push_back(runBench("createContent", "page", store.Size(), std::filesystem::file_size(resultDir / "content.txt"), writerSamples, [&] {
+        g_sink = g_sink + writeContent(resultDir.string(), store, threads);
+    }));
+    std::filesystem::remove_all(resultDir);
+
+    std::cout << hrefs.size() << " odkazu, " << absoluteUrls.size() << " absolutnich URL, " << store.Size() << " stranek k zapisu ("
+              << threads << " vlaken)" << std::endl;
+    printTable(results);
+    writeJson(jsonPath, results, corpus, corpusBytes);
+    std::cout << "Vysledky ulozeny do " << jsonPath << std::endl;
+    return 0;
+}
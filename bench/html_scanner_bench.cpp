@@ -0,0 +1,127 @@
+/**
+ * Porovnani puvodni analyzy pomoci std::regex a jednopruchodoveho scanneru (html_scanner.h)
+ * vcetne jednotlivych jader pro hledani znaku '<' (skalarni, SSE2, AVX2)
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <regex>
+#include <chrono>
+#include <cstdlib>
+#include <cctype>
+
+#include "../src/html_scanner.h"
+
+// kolikrat se ma provest experiment (a mereni)
+constexpr size_t RunCount = 5;
+
+// Puvodni implementace z analyzeHtml - ctyri samostatne pruchody regularnimi vyrazy
+static void scanRegex(const std::string& html, HtmlScanResult& result) {
+    std::regex imgRegex("<img[^>]*>");
+    std::regex linkRegex("<a[^>]*href=[\"']([^\"']+)[\"'][^>]*>");
+    std::regex formRegex("<form[^>]*>");
+    std::regex headerRegex("<h([1-6])[^>]*>(.*?)</h\\1>");
+
+    result.imageCount = std::distance(std::sregex_iterator(html.begin(), html.end(), imgRegex), std::sregex_iterator());
+    result.formCount = std::distance(std::sregex_iterator(html.begin(), html.end(), formRegex), std::sregex_iterator());
+
+    for (auto it = std::sregex_iterator(html.begin(), html.end(), linkRegex); it != std::sregex_iterator(); ++it) {
+        result.hrefs.push_back((*it)[1]);
+    }
+    result.linkCount = result.hrefs.size();
+
+    std::string::const_iterator searchStart(html.cbegin());
+    std::smatch headerMatch;
+    while (std::regex_search(searchStart, html.cend(), headerMatch, headerRegex)) {
+        std::regex tagRegex("<[^>]*>");
+        result.headers.push_back({ std::stoi(headerMatch[1]), std::regex_replace(std::string(headerMatch[2]), tagRegex, "") });
+        searchStart = headerMatch.suffix().first;
+    }
+}
+
+// Vygeneruje syntetickou stranku o priblizne zadane velikosti
+static std::string generatePage(size_t targetSize) {
+    std::string html = "<html><head><title>bench</title></head><body>\n";
+    for (size_t i = 0; html.size() < targetSize; i++) {
+        html += "<h" + std::to_string(i % 6 + 1) + " class=\"title\">Sekce <b>" + std::to_string(i) + "</b></h" + std::to_string(i % 6 + 1) + ">\n";
+        html += "<div class=\"row\"><p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.</p>\n";
+        html += "<a class=\"link\" href=\"/page/" + std::to_string(i) + ".html\">odkaz</a> <img src=\"/img/" + std::to_string(i) + ".png\" alt=\"\">\n";
+        if (i % 10 == 0) {
+            html += "<form action=\"/search\" method=\"get\"><input name=\"q\"></form>\n";
+        }
+        html += "</div>\n";
+    }
+    html += "</body></html>\n";
+    return html;
+}
+
+template<typename TFnc>
+static unsigned long long measure(const std::string& name, TFnc fnc) {
+    std::cout << "Measurement: " << name << std::endl;
+
+    // Nejdrive spustime "naprazdno" pro inicializaci
+    fnc();
+
+    unsigned long long tm = 0;
+    for (size_t i = 0; i < RunCount; i++) {
+        auto st = std::chrono::steady_clock::now();
+        fnc();
+        auto end = std::chrono::steady_clock::now();
+        tm += std::chrono::duration_cast<std::chrono::microseconds>(end - st).count();
+    }
+    tm /= RunCount;
+
+    std::cout << "Average time: " << tm << " us" << std::endl << std::endl;
+    return tm;
+}
+
+int main(int argc, char** argv) {
+    size_t pageSize = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4 * 1024 * 1024;
+    std::string html = generatePage(pageSize);
+    std::cout << "Page size: " << html.size() << " B" << std::endl << std::endl;
+
+    HtmlScanResult regexResult;
+    unsigned long long tmRegex = measure("std::regex (4 passes)", [&]() { regexResult = HtmlScanResult{}; scanRegex(html, regexResult); });
+
+    // stejna stranka s tagy velkymi pismeny musi dat stejny vysledek
+    std::string upperHtml = html;
+    for (size_t pos = upperHtml.find('<'); pos != std::string::npos; pos = upperHtml.find('<', pos + 1)) {
+        for (size_t i = pos + 1; i < upperHtml.size() && std::isalnum(static_cast<unsigned char>(upperHtml[i])); i++) {
+            upperHtml[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(upperHtml[i])));
+        }
+    }
+
+    auto sameResult = [](const HtmlScanResult& a, const HtmlScanResult& b) {
+        return a.imageCount == b.imageCount && a.linkCount == b.linkCount && a.formCount == b.formCount
+            && a.hrefs == b.hrefs && a.headers == b.headers;
+    };
+
+    bool same = true;
+    unsigned long long tmScalar = 0;
+    for (ScanKernel kernel : { ScanKernel::Scalar, ScanKernel::SSE2, ScanKernel::AVX2 }) {
+        if (!isScanKernelSupported(kernel)) {
+            std::cout << "Kernel " << scanKernelName(kernel) << " is not supported, skipping" << std::endl << std::endl;
+            continue;
+        }
+
+        HtmlScanResult scanResult, upperResult;
+        unsigned long long tm = measure(std::string("scanHtml (1 pass, ") + scanKernelName(kernel) + ")", [&]() { scanResult = HtmlScanResult{}; scanHtml(html, scanResult, kernel); });
+        scanHtml(upperHtml, upperResult, kernel);
+
+        if (kernel == ScanKernel::Scalar) {
+            tmScalar = tm;
+        }
+
+        bool kernelSame = sameResult(regexResult, scanResult) && sameResult(scanResult, upperResult);
+        same = same && kernelSame;
+
+        std::cout << "Results identical (incl. upper-case tags): " << (kernelSame ? "yes" : "NO") << std::endl;
+        std::cout << "Speedup vs. regex: " << (tm ? static_cast<double>(tmRegex) / tm : 0.0) << "x" << std::endl;
+        std::cout << "Speedup vs. scalar: " << (tm ? static_cast<double>(tmScalar) / tm : 0.0) << "x" << std::endl << std::endl;
+    }
+
+    std::cout << "Auto-selected kernel: " << scanKernelName(ScanKernel::Auto) << std::endl;
+
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
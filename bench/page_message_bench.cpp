@@ -0,0 +1,114 @@
+/**
+ * Porovnani prenosu PageAnalysisResult z Worker B do Worker A: puvodni protokol (samostatne MPI_Send pro kazde cislo
+ * a retezec) vs. jedna zakodovana zprava. Pocita zpravy a bajty na stranku a meri rychlost kodovani/dekodovani.
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "../src/page_message.h"
+
+// stranka s danym poctem odkazu a nadpisu
+static PageAnalysisResult makePage(size_t links, size_t headers) {
+    PageAnalysisResult page;
+    page.url = "https://www.example.com/catalog/section-7/item/1234/detail.html";
+    page.imageCount = 12;
+    page.linkCount = static_cast<int>(links);
+    page.formCount = 1;
+    for (size_t i = 0; i < headers; i++) {
+        page.headers.push_back({ static_cast<int>(i % 3) + 1, "Section heading number " + std::to_string(i) });
+    }
+    for (size_t i = 0; i < links; i++) {
+        page.foundUrls.push_back("https://www.example.com/catalog/section-" + std::to_string(i % 17) + "/item/" + std::to_string(i * 31) + "/detail.html");
+    }
+    return page;
+}
+
+struct Traffic {
+    size_t messages = 0;
+    size_t bytes = 0;
+};
+
+// puvodni workerB: ohlaseni (TERMINATE), URL (delka + data), 4 cisla, 3 zpravy na nadpis, pocet URL, 2 zpravy na URL
+static Traffic legacyTraffic(const PageAnalysisResult& page) {
+    Traffic t;
+    auto sendInt = [&t]() { t.messages++; t.bytes += sizeof(int); };
+    auto sendString = [&t, &sendInt](const std::string& s) { sendInt(); t.messages++; t.bytes += s.size(); };
+
+    sendInt();
+    sendString(page.url);
+    sendInt();
+    sendInt();
+    sendInt();
+    sendInt();
+    for (const auto& header : page.headers) {
+        sendInt();
+        sendString(header.second);
+    }
+    sendInt();
+    for (const auto& url : page.foundUrls) {
+        sendString(url);
+    }
+    return t;
+}
+
+int main() {
+    std::cout << std::left << std::setw(20) << "page"
+              << std::setw(18) << "legacy msgs" << std::setw(18) << "legacy bytes"
+              << std::setw(18) << "packed msgs" << std::setw(18) << "packed bytes" << std::endl;
+
+    const size_t sizes[][2] = { { 0, 0 }, { 10, 3 }, { 50, 8 }, { 100, 12 } };
+    for (const auto& size : sizes) {
+        PageAnalysisResult page = makePage(size[0], size[1]);
+        Traffic legacy = legacyTraffic(page);
+
+        std::string name = std::to_string(size[0]) + " links/" + std::to_string(size[1]) + " h";
+        std::cout << std::setw(20) << name
+                  << std::setw(18) << legacy.messages << std::setw(18) << legacy.bytes
+                  << std::setw(18) << 1 << std::setw(18) << encodedPageSize(page) << std::endl;
+    }
+
+    // rychlost kodovani a dekodovani stranky se 100 odkazy
+    const size_t iterations = 200000;
+    PageAnalysisResult page = makePage(100, 12);
+    CMessageBufferPool pool;
+    PageAnalysisResult decoded;
+    std::vector<char> message;
+    size_t totalBytes = 0;
+    size_t failures = 0;
+
+    auto st = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        encodePage(page, message);
+
+        // stejna cesta jako Worker A: buffer ze zasobniku, dekodovani, vraceni bufferu
+        std::vector<char> received = pool.Acquire(message.size());
+        std::copy(message.begin(), message.end(), received.begin());
+        if (!decodePage(received.data(), received.size(), decoded)) {
+            failures++;
+        }
+        totalBytes += received.size();
+        pool.Release(std::move(received));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - st).count();
+
+    bool same = decoded.url == page.url && decoded.foundUrls == page.foundUrls && decoded.headers == page.headers
+        && decoded.imageCount == page.imageCount && decoded.linkCount == page.linkCount && decoded.formCount == page.formCount;
+
+    std::cout << std::endl;
+    std::cout << "Encode+decode (100 links): " << static_cast<size_t>(iterations / seconds) << " pages/s, "
+              << (totalBytes / seconds) / (1024.0 * 1024.0) << " MiB/s" << std::endl;
+    std::cout << "Receive buffer allocations: " << pool.Allocations() << " for " << iterations << " messages" << std::endl;
+    std::cout << "Round trip " << (same && failures == 0 ? "OK" : "FAILED") << std::endl;
+
+    // poskozena zprava musi byt odmitnuta
+    encodePage(page, message);
+    bool truncatedRejected = !decodePage(message.data(), message.size() - 1, decoded);
+    std::cout << "Truncated message rejected: " << (truncatedRejected ? "yes" : "NO") << std::endl;
+
+    return (same && failures == 0 && truncatedRejected) ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/**
+ * Pamet vysledku obchazeni na stranku: std::unordered_map<std::string, PageAnalysisResult> (puvodni ulozeni
+ * v lokalnich rezimech) vs. CResultStore. Pamet se meri jako zive bajty na halde (nahrazeny globalni operator new)
+ * vcetne rezie alokatoru 16 B na alokaci; vypise i pocet zivych alokaci a dobu vlozeni.
+ * Overuje, ze CResultStore vrati stejne stranky, i kdyz je prvnim internovanym textem prazdny nadpis.
+ *
+ * Pouziti: result_store_bench [pocet stranek]
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+
+#include "../src/result_store.h"
+
+namespace {
+    // rezie jedne alokace v glibc malloc (hlavicka a zarovnani) - odhad, aby drobne alokace nebyly podhodnocene
+    constexpr size_t AllocatorOverhead = 16;
+
+    size_t g_liveBytes = 0;
+    size_t g_liveAllocations = 0;
+}
+
+// velikost alokace je ulozena pred blokem, aby ji delete mohl odecist
+void* operator new(size_t size) {
+    void* block = std::malloc(size + alignof(std::max_align_t));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    g_liveBytes += size + AllocatorOverhead;
+    g_liveAllocations++;
+    return static_cast<char*>(block) + alignof(std::max_align_t);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    void* block = static_cast<char*>(pointer) - alignof(std::max_align_t);
+    g_liveBytes -= *static_cast<size_t*>(block) + AllocatorOverhead;
+    g_liveAllocations--;
+    std::free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+// syntheticka stranka webu: 20 odkazu navigace a 3 nadpisy spolecne vsem strankam, 10 odkazu na dalsi stranky,
+// 2 externi odkazy a 2 vlastni nadpisy
+static PageAnalysisResult makePage(size_t i, size_t pages) {
+    auto pageUrl = [](size_t n) { return "http://www.example-site.test/catalog/section/item-" + std::to_string(n) + ".html"; };
+
+    PageAnalysisResult page;
+    page.url = pageUrl(i);
+    page.imageCount = static_cast<int>(i % 23);
+    page.formCount = static_cast<int>(i % 2);
+    for (size_t k = 0; k < 20; k++) {
+        page.foundUrls.push_back("http://www.example-site.test/nav/" + std::to_string(k) + ".html");
+    }
+    for (size_t k = 1; k <= 10; k++) {
+        page.foundUrls.push_back(pageUrl((i * 7 + k * 131) % pages));
+    }
+    page.foundUrls.push_back("http://other.test/ref/" + std::to_string(i));
+    page.foundUrls.push_back("http://cdn.other.test/share?u=" + std::to_string(i));
+    page.linkCount = static_cast<int>(page.foundUrls.size());
+    page.headers.push_back({ 1, "Example Site" });
+    page.headers.push_back({ 2, "Item " + std::to_string(i) + " - detailed description" });
+    page.headers.push_back({ 2, "Related items" });
+    page.headers.push_back({ 3, "Specification of item " + std::to_string(i) });
+    page.headers.push_back({ 3, "Contact" });
+    return page;
+}
+
+static bool samePage(const PageAnalysisResult& a, const PageAnalysisResult& b) {
+    return a.url == b.url && a.foundUrls == b.foundUrls && a.headers == b.headers && a.imageCount == b.imageCount
+        && a.linkCount == b.linkCount && a.formCount == b.formCount && a.aliasOf == b.aliasOf;
+}
+
+int main(int argc, char** argv) {
+    size_t pageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    auto row = [pageCount](const std::string& name, size_t bytes, size_t allocations, double seconds) {
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << static_cast<double>(bytes) / pageCount
+                  << std::setw(16) << static_cast<double>(allocations) / pageCount
+                  << std::setw(12) << std::setprecision(3) << seconds << std::endl;
+    };
+
+    // nadpis jen s obrazkem (<h1><a href="/"><img src="logo.png"></a></h1>) ma prazdny text - prvni retezec
+    // tabulky textu nadpisu pak nesmi zustat bez bloku areny
+    bool same = true;
+    {
+        PageAnalysisResult logoPage = makePage(0, 1);
+        logoPage.headers.insert(logoPage.headers.begin(), { 1, "" });
+        CResultStore store;
+        store.Add(logoPage.url, logoPage);
+        PageAnalysisResult emptyPage;
+        emptyPage.url = "http://www.example-site.test/empty.html";
+        emptyPage.imageCount = 0;
+        emptyPage.linkCount = 0;
+        emptyPage.formCount = 0;
+        emptyPage.headers.push_back({ 2, "" });
+        store.Add(emptyPage.url, emptyPage);
+        same = samePage(store.Materialize(0), logoPage) && samePage(store.Materialize(1), emptyPage);
+        std::cout << (same ? "Empty header OK" : "Empty header DIFFERS") << std::endl;
+    }
+
+    std::cout << pageCount << " pages" << std::endl;
+    std::cout << std::left << std::setw(40) << "storage" << std::right << std::setw(14) << "bytes/page"
+              << std::setw(16) << "allocs/page" << std::setw(12) << "insert [s]" << std::endl;
+
+    {
+        size_t bytesBefore = g_liveBytes;
+        size_t allocationsBefore = g_liveAllocations;
+        double seconds = 0;
+        std::unordered_map<std::string, PageAnalysisResult> results;
+        for (size_t i = 0; i < pageCount; i++) {
+            // cas jen vlozeni, bez tvorby synteticke stranky
+            PageAnalysisResult page = makePage(i, pageCount);
+            auto start = std::chrono::steady_clock::now();
+            std::string url = page.url;
+            results[url] = std::move(page);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        row("unordered_map<string, PageAnalysisResult>", g_liveBytes - bytesBefore, g_liveAllocations - allocationsBefore, seconds);
+    }
+    {
+        size_t bytesBefore = g_liveBytes;
+        size_t allocationsBefore = g_liveAllocations;
+        double seconds = 0;
+        CResultStore store;
+        for (size_t i = 0; i < pageCount; i++) {
+            PageAnalysisResult page = makePage(i, pageCount);
+            auto start = std::chrono::steady_clock::now();
+            store.Add(page.url, page);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        row("CResultStore", g_liveBytes - bytesBefore, g_liveAllocations - allocationsBefore, seconds);
+        std::cout << "CResultStore::Memory_Usage: " << std::setprecision(1)
+                  << static_cast<double>(store.Memory_Usage()) / pageCount << " bytes/page" << std::endl;
+
+        for (size_t i = 0; i < pageCount && same; i += 997) {
+            same = samePage(store.Materialize(static_cast<CResultStore::PageIndex>(i)), makePage(i, pageCount));
+        }
+    }
+    std::cout << (same ? "Pages identical" : "Pages DIFFER") << std::endl;
+    return same ? 0 : 1;
+}
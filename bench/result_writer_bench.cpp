@@ -0,0 +1,175 @@
+/**
+ * Zapis vysledku 1M stranek (map.txt a content.txt): puvodni zapis pres std::ofstream a std::endl (kazdy radek
+ * vynuti zapis do souboru) vs. formatovani pres std::to_chars do bufferu a velke sekvencni zapisy, sekvencne
+ * a paralelne. Overuje, ze vystup je bajtove shodny a ze prevod graph.bin zpet na text (writeMapText, graph_to_map)
+ * da stejny map.txt.
+ *
+ * Pouziti: result_writer_bench [pocet stranek] [pocet vlaken]
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+
+#include "../src/result_writer.h"
+#include "../src/link_graph.h"
+
+// syntheticky vysledek: kazda stranka odkazuje na 5 obchazenych stranek a 1 externi; kazda desata navic znovu
+// na prvni cil az po ostatnich (opakovani s prestavkou) a kazda desata s posunem 1 na posledni cil hned za sebou
+static std::unordered_map<std::string, PageAnalysisResult> makeResults(size_t pages) {
+    std::unordered_map<std::string, PageAnalysisResult> results;
+    results.reserve(pages);
+    auto pageUrl = [](size_t i) { return "http://site.test/p/" + std::to_string(i) + ".html"; };
+
+    for (size_t i = 0; i < pages; i++) {
+        PageAnalysisResult page;
+        page.url = pageUrl(i);
+        page.imageCount = static_cast<int>(i % 23);
+        page.linkCount = 6;
+        page.formCount = static_cast<int>(i % 2);
+        for (size_t k = 1; k <= 5; k++) {
+            page.foundUrls.push_back(pageUrl((i * 7 + k * 131) % pages));
+        }
+        if (i % 10 == 0) {
+            page.foundUrls.push_back(page.foundUrls.front());
+        } else if (i % 10 == 1) {
+            page.foundUrls.push_back(page.foundUrls.back());
+        }
+        page.foundUrls.push_back("http://other.test/" + std::to_string(i));
+        page.headers.push_back({ 1, "Page " + std::to_string(i) });
+        page.headers.push_back({ 2, "Section" });
+        page.headers.push_back({ 3, "Detail" });
+        results.emplace(page.url, std::move(page));
+    }
+    return results;
+}
+
+// Puvodni implementace z main.cpp (pred zavedenim buffered_writer.h)
+static void legacyWebGraph(const std::string& resultDir, const std::unordered_map<std::string, PageAnalysisResult>& results) {
+    std::ofstream mapFile(resultDir + "/map.txt");
+    for (const auto& pair : results) {
+        mapFile << pair.first << std::endl;
+    }
+    for (const auto& pair : results) {
+        const std::string& sourceUrl = pair.first;
+        for (const std::string& targetUrl : pair.second.foundUrls) {
+            if (results.find(targetUrl) != results.end()) {
+                mapFile << sourceUrl << " " << targetUrl << std::endl;
+            }
+        }
+    }
+}
+
+static void legacyContent(const std::string& resultDir, const std::unordered_map<std::string, PageAnalysisResult>& results) {
+    std::ofstream contentFile(resultDir + "/content.txt");
+    for (const auto& pair : results) {
+        contentFile << pair.first << std::endl;
+        contentFile << "IMAGES " << pair.second.imageCount << std::endl;
+        contentFile << "LINKS " << pair.second.linkCount << std::endl;
+        contentFile << "FORMS " << pair.second.formCount << std::endl;
+        for (const auto& header : pair.second.headers) {
+            contentFile << std::string(header.first, '-') << " " << header.second << std::endl;
+        }
+        contentFile << std::endl;
+    }
+}
+
+static double measure(const std::function<void()>& fnc) {
+    auto st = std::chrono::steady_clock::now();
+    fnc();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - st).count();
+}
+
+// porovna soubory po blocich
+static bool sameFile(const std::string& a, const std::string& b) {
+    std::ifstream fa(a, std::ios::binary);
+    std::ifstream fb(b, std::ios::binary);
+    std::vector<char> ba(1 << 20);
+    std::vector<char> bb(1 << 20);
+    while (fa && fb) {
+        fa.read(ba.data(), static_cast<std::streamsize>(ba.size()));
+        fb.read(bb.data(), static_cast<std::streamsize>(bb.size()));
+        if (fa.gcount() != fb.gcount() || !std::equal(ba.begin(), ba.begin() + fa.gcount(), bb.begin())) {
+            return false;
+        }
+    }
+    return fa.eof() && fb.eof();
+}
+
+int main(int argc, char** argv) {
+    size_t pageCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    auto results = makeResults(pageCount);
+    // stranky v poradi iterace mapy - vystup pak musi byt stejny jako z puvodni implementace
+    CResultStore store;
+    for (const auto& pair : results) {
+        store.Add(pair.first, pair.second);
+    }
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "result_writer_bench";
+    std::string legacyDir = (root / "legacy").string();
+    std::string serialDir = (root / "serial").string();
+    std::string parallelDir = (root / "parallel").string();
+    for (const auto& dir : { legacyDir, serialDir, parallelDir }) {
+        std::filesystem::create_directories(dir);
+    }
+
+    double legacyMap = measure([&]() { legacyWebGraph(legacyDir, results); });
+    double legacyRecords = measure([&]() { legacyContent(legacyDir, results); });
+    // writeWebGraph navic zapisuje graph.bin
+    double serialMap = measure([&]() { writeWebGraph(serialDir, store, 1); });
+    double serialRecords = measure([&]() { writeContent(serialDir, store, 1); });
+    double parallelMap = measure([&]() { writeWebGraph(parallelDir, store, threads); });
+    double parallelRecords = measure([&]() { writeContent(parallelDir, store, threads); });
+
+    double mapMiB = std::filesystem::file_size(legacyDir + "/map.txt") / (1024.0 * 1024.0);
+    double contentMiB = std::filesystem::file_size(legacyDir + "/content.txt") / (1024.0 * 1024.0);
+
+    auto row = [&](const std::string& name, double map, double content) {
+        std::cout << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << map << std::setw(12) << mapMiB / map
+                  << std::setw(12) << content << std::setw(12) << contentMiB / content << std::endl;
+    };
+
+    std::cout << pageCount << " pages, map.txt " << std::setprecision(1) << std::fixed << mapMiB << " MiB, content.txt "
+              << contentMiB << " MiB" << std::endl;
+    std::cout << std::left << std::setw(26) << "writer" << std::right << std::setw(12) << "map [s]" << std::setw(12) << "MiB/s"
+              << std::setw(12) << "content [s]" << std::setw(12) << "MiB/s" << std::endl;
+    row("ofstream + std::endl", legacyMap, legacyRecords);
+    row("buffered, sequential", serialMap, serialRecords);
+    row("buffered, parallel (" + std::to_string(threads) + ")", parallelMap, parallelRecords);
+
+    bool same = true;
+    for (const auto& dir : { serialDir, parallelDir }) {
+        same = same && sameFile(legacyDir + "/map.txt", dir + "/map.txt") && sameFile(legacyDir + "/content.txt", dir + "/content.txt");
+    }
+    std::cout << "Output " << (same ? "identical" : "DIFFERENT") << std::endl;
+
+    CLinkGraphView graph;
+    std::string error;
+    bool graphSame = graph.Open(serialDir + "/graph.bin", error);
+    if (graphSame) {
+        std::ofstream out(serialDir + "/graph_map.txt");
+        writeMapText(graph, out);
+        out.close();
+        graphSame = sameFile(legacyDir + "/map.txt", serialDir + "/graph_map.txt");
+    } else {
+        std::cout << error << std::endl;
+    }
+    std::cout << "graph.bin -> map.txt " << (graphSame ? "identical" : "DIFFERENT") << std::endl;
+    same = same && graphSame;
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/**
+ * Porovnani puvodnich getBaseUrl/normalizeUrl (std::regex, substr) s rozkladem URL podle RFC 3986 (url_resolver.h)
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <regex>
+#include <chrono>
+#include <cstdlib>
+
+#include "../src/url_resolver.h"
+
+// kolikrat se ma provest experiment (a mereni)
+constexpr size_t RunCount = 5;
+
+// Puvodni implementace z main.cpp
+static std::string oldGetBaseUrl(const std::string& url) {
+    std::regex urlRegex("(https?://[^/]+(?:/[^/]+)?)");
+    std::smatch match;
+    if (std::regex_search(url, match, urlRegex)) {
+        return match[1];
+    }
+    return url;
+}
+
+static std::string oldNormalizeUrl(const std::string& baseUrl, const std::string& url) {
+    if (url.empty()) return "";
+
+    if (url.find("http://") == 0 || url.find("https://") == 0) {
+        return url;
+    }
+
+    std::string result = baseUrl;
+
+    size_t fragmentPos = url.find('#');
+    std::string cleanUrl = (fragmentPos != std::string::npos) ? url.substr(0, fragmentPos) : url;
+
+    if (cleanUrl[0] == '/') {
+        size_t protocolPos = baseUrl.find("://");
+        if (protocolPos != std::string::npos) {
+            size_t pathStart = baseUrl.find('/', protocolPos + 3);
+            if (pathStart != std::string::npos) {
+                result = baseUrl.substr(0, pathStart);
+            }
+        }
+        result += cleanUrl;
+    } else {
+        if (result.back() != '/') {
+            size_t lastSlash = result.find_last_of('/');
+            if (lastSlash != std::string::npos) {
+                result = result.substr(0, lastSlash + 1);
+            } else {
+                result += '/';
+            }
+        }
+        result += cleanUrl;
+    }
+
+    return result;
+}
+
+template<typename TFnc>
+static double measure(const std::string& name, size_t operations, TFnc fnc) {
+    std::cout << "Measurement: " << name << std::endl;
+
+    // Nejdrive spustime "naprazdno" pro inicializaci
+    fnc();
+
+    double total = 0;
+    for (size_t i = 0; i < RunCount; i++) {
+        auto st = std::chrono::steady_clock::now();
+        fnc();
+        auto end = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double>(end - st).count();
+    }
+
+    double perSecond = operations * RunCount / total;
+    std::cout << "Resolutions per second: " << static_cast<size_t>(perSecond) << std::endl << std::endl;
+    return perSecond;
+}
+
+int main(int argc, char** argv) {
+    size_t pages = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    // typicka skladba odkazu na strance
+    const std::vector<std::string> hrefs = {
+        "/", "/about/", "contact.html", "./team.html", "../index.html", "../../assets/logo.png",
+        "?page=2", "#top", "//cdn.example.com/lib.js", "https://www.example.com/docs/guide/intro.html",
+        "HTTPS://WWW.EXAMPLE.COM:443/Docs/", "mailto:info@example.com", "/docs/guide/../api/./reference.html#section-2",
+        "section/chapter-1.html?lang=en", "javascript:void(0)", "https://other.org/page"
+    };
+
+    std::vector<std::string> pageUrls;
+    for (size_t i = 0; i < pages; i++) {
+        pageUrls.push_back("https://www.example.com/docs/guide/page-" + std::to_string(i) + ".html");
+    }
+    size_t operations = pages * hrefs.size();
+
+    size_t checksum = 0;
+
+    double oldRate = measure("std::regex getBaseUrl + substr normalizeUrl", operations, [&]() {
+        for (const auto& page : pageUrls) {
+            std::string baseUrl = oldGetBaseUrl(page);
+            for (const auto& href : hrefs) {
+                checksum += oldNormalizeUrl(baseUrl, href).size();
+            }
+        }
+    });
+
+    double newRate = measure("getBaseUrl + resolveUrl (reusable buffer)", operations, [&]() {
+        std::string buffer;
+        for (const auto& page : pageUrls) {
+            std::string baseUrl = getBaseUrl(page);
+            checksum += baseUrl.size();
+            for (const auto& href : hrefs) {
+                resolveUrl(page, href, buffer);
+                checksum += buffer.size();
+            }
+        }
+    });
+
+    std::cout << "Speedup: " << newRate / oldRate << "x (checksum " << checksum << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/**
+ * Porovnani mnozin navstivenych URL: std::unordered_set<std::string>, CUrlTable a CFingerprintSet (s Bloomovym filtrem i bez)
+ * Meri pamet na URL a pocet dotazu za sekundu.
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_set>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#include "../src/url_table.h"
+#include "../src/visited_set.h"
+
+// pocitadlo alokovane pameti - prepisuje globalni operator new/delete
+static size_t g_allocatedBytes = 0;
+
+void* operator new(size_t size) {
+    // velikost ulozime pred blok, aby ji delete mohl odecist
+    size_t* block = static_cast<size_t*>(std::malloc(size + sizeof(size_t) * 2));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    block[0] = size;
+    g_allocatedBytes += size;
+    return block + 2;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        size_t* block = static_cast<size_t*>(ptr) - 2;
+        g_allocatedBytes -= block[0];
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+// vygeneruje URL podobne skutecnemu crawlu jedne domeny
+static std::vector<std::string> generateUrls(size_t count) {
+    std::vector<std::string> urls;
+    urls.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        urls.push_back("https://www.example.com/catalog/section-" + std::to_string(i % 97) + "/item/" + std::to_string(i) + "/detail.html");
+    }
+    return urls;
+}
+
+// memBefore - stav pocitadla pred vytvorenim mnoziny, aby se zapocitala i predalokovana pamet
+template<typename TInsert, typename TContains>
+static void measure(const std::string& name, size_t memBefore, const std::vector<std::string>& urls, const std::vector<std::string>& misses, TInsert insert, TContains contains) {
+
+    auto st = std::chrono::steady_clock::now();
+    for (const auto& url : urls) {
+        insert(url);
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    size_t memory = g_allocatedBytes - memBefore;
+
+    // polovina dotazu na navstivene URL, polovina na nove
+    size_t found = 0;
+    for (size_t i = 0; i < urls.size(); i++) {
+        found += contains(urls[i]) ? 1 : 0;
+        found += contains(misses[i]) ? 1 : 0;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double insertSec = std::chrono::duration<double>(mid - st).count();
+    double lookupSec = std::chrono::duration<double>(end - mid).count();
+
+    std::cout << name << std::endl;
+    std::cout << "  memory: " << memory / urls.size() << " B/URL (" << memory / (1024 * 1024) << " MiB)" << std::endl;
+    std::cout << "  inserts: " << static_cast<size_t>(urls.size() / insertSec) << " /s" << std::endl;
+    std::cout << "  lookups: " << static_cast<size_t>(2 * urls.size() / lookupSec) << " /s (found " << found << " of " << urls.size() << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<std::string> urls = generateUrls(count);
+    std::vector<std::string> misses;
+    misses.reserve(count);
+    for (const auto& url : urls) {
+        misses.push_back(url + "?print=1");
+    }
+
+    std::cout << "URLs: " << count << std::endl << std::endl;
+
+    {
+        size_t memBefore = g_allocatedBytes;
+        std::unordered_set<std::string> set;
+        measure("std::unordered_set<std::string>", memBefore, urls, misses,
+            [&](const std::string& url) { set.insert(url); },
+            [&](const std::string& url) { return set.find(url) != set.end(); });
+    }
+    {
+        size_t memBefore = g_allocatedBytes;
+        CUrlTable table;
+        measure("CUrlTable (exact, interned)", memBefore, urls, misses,
+            [&](const std::string& url) { table.Intern(url); },
+            [&](const std::string& url) { return table.Contains(url); });
+    }
+    {
+        size_t memBefore = g_allocatedBytes;
+        CFingerprintSet set(CFingerprintSet::Config{ count, false, 0.01 });
+        measure("CFingerprintSet", memBefore, urls, misses,
+            [&](const std::string& url) { set.Insert(url); },
+            [&](const std::string& url) { return set.Contains(url); });
+        std::cout << "  expected collision rate: " << set.Get_Stats().expectedCollisionRate << std::endl;
+    }
+    {
+        size_t memBefore = g_allocatedBytes;
+        CFingerprintSet set(CFingerprintSet::Config{ count, true, 0.01 });
+        measure("CFingerprintSet + Bloom (p = 0.01)", memBefore, urls, misses,
+            [&](const std::string& url) { set.Insert(url); },
+            [&](const std::string& url) { return set.Contains(url); });
+        CFingerprintSet::Stats stats = set.Get_Stats();
+        std::cout << "  Bloom negatives: " << stats.bloomNegatives << ", false positives: " << stats.bloomFalsePositives
+                  << " (" << 100.0 * stats.bloomFalsePositives / std::max<size_t>(1, stats.lookups - stats.bloomNegatives) << " % of maybe answers)" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/**
+ * Rychly zapis vysledku - formatovani zaznamu bez iostreamu a velke sekvencni zapisy do souboru
+ */
+
+#include "buffered_writer.h"
+
+#include <charconv>
+
+namespace {
+	void appendInt(std::string& out, int value) {
+		char digits[16];
+		auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+		out.append(digits, end);
+	}
+}
+
+void appendNodeLine(std::string& out, std::string_view url) {
+	out.append(url);
+	out.push_back('\n');
+}
+
+void appendEdgeLine(std::string& out, std::string_view source, std::string_view target) {
+	out.append(source);
+	out.push_back(' ');
+	out.append(target);
+	out.push_back('\n');
+}
+
+void appendContentHead(std::string& out, std::string_view url, int imageCount, int linkCount, int formCount) {
+	out.append(url);
+	out.append("\nIMAGES ");
+	appendInt(out, imageCount);
+	out.append("\nLINKS ");
+	appendInt(out, linkCount);
+	out.append("\nFORMS ");
+	appendInt(out, formCount);
+	out.push_back('\n');
+}
+
+void appendHeaderLine(std::string& out, int level, std::string_view text) {
+	out.append(level > 0 ? static_cast<size_t>(level) : 0, '-');
+	out.push_back(' ');
+	out.append(text);
+	out.push_back('\n');
+}
+
+void appendContentRecord(std::string& out, std::string_view url, const PageAnalysisResult& page) {
+	appendContentHead(out, url, page.imageCount, page.linkCount, page.formCount);
+	for (const auto& header : page.headers) {
+		appendHeaderLine(out, header.first, header.second);
+	}
+	out.push_back('\n');
+}
+
+CBufferedFileWriter::CBufferedFileWriter(const std::string& path, size_t bufferSize)
+	: m_file{ std::fopen(path.c_str(), "wb") }, m_bufferSize{ bufferSize } {
+	if (!m_file) {
+		m_failed = true;
+	}
+	else {
+		// vlastni buffer nahrazuje buffer stdio - zapisy jdou do souboru primo po celych blocich
+		std::setvbuf(m_file, nullptr, _IONBF, 0);
+	}
+	m_buffer.reserve(m_bufferSize);
+}
+
+CBufferedFileWriter::~CBufferedFileWriter() {
+	Close();
+}
+
+void CBufferedFileWriter::Write_Buffer() {
+	if (!m_buffer.empty() && m_file) {
+		if (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size()) {
+			m_failed = true;
+		}
+	}
+	m_buffer.clear();
+}
+
+void CBufferedFileWriter::Commit() {
+	if (m_buffer.size() >= m_bufferSize) {
+		Write_Buffer();
+	}
+}
+
+void CBufferedFileWriter::Append(std::string_view data) {
+	if (m_buffer.size() + data.size() <= m_bufferSize) {
+		m_buffer.append(data);
+		return;
+	}
+	Write_Buffer();
+	if (data.size() >= m_bufferSize) {
+		if (m_file && std::fwrite(data.data(), 1, data.size(), m_file) != data.size()) {
+			m_failed = true;
+		}
+		return;
+	}
+	m_buffer.append(data);
+}
+
+void CBufferedFileWriter::Flush() {
+	Write_Buffer();
+	if (m_file && std::fflush(m_file) != 0) {
+		m_failed = true;
+	}
+}
+
+void CBufferedFileWriter::Close() {
+	if (!m_file) {
+		return;
+	}
+	Write_Buffer();
+	if (std::fclose(m_file) != 0) {
+		m_failed = true;
+	}
+	m_file = nullptr;
+}
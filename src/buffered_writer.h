@@ -0,0 +1,108 @@
+/**
+ * Rychly zapis vysledku - formatovani zaznamu bez iostreamu (std::to_chars), velke sekvencni zapisy do souboru
+ * a paralelni formatovani useku do vlastnich bufferu vlaken
+ *
+ * Vystup je bajtove shodny s puvodnim zapisem pres std::ofstream a std::endl.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <cstddef>
+
+#include "page_analysis.h"
+
+// radek uzlu v map.txt: "url\n"
+void appendNodeLine(std::string& out, std::string_view url);
+
+// radek hrany v map.txt: "zdroj cil\n"
+void appendEdgeLine(std::string& out, std::string_view source, std::string_view target);
+
+// zaznam stranky v content.txt (URL, IMAGES/LINKS/FORMS, nadpisy s pomlckami podle urovne, prazdny radek)
+void appendContentRecord(std::string& out, std::string_view url, const PageAnalysisResult& page);
+
+// zaznam po castech (result_store.h): URL a IMAGES/LINKS/FORMS, pak radky nadpisu a nakonec prazdny radek
+void appendContentHead(std::string& out, std::string_view url, int imageCount, int linkCount, int formCount);
+void appendHeaderLine(std::string& out, int level, std::string_view text);
+
+// soubor zapisovany po velkych blocich; data se hromadi v bufferu a zapisuji se, az je buffer plny
+class CBufferedFileWriter {
+	public:
+		static constexpr size_t DefaultBufferSize = 1 << 20;
+
+	private:
+		std::FILE* m_file{ nullptr };
+		std::string m_buffer;
+		size_t m_bufferSize;
+		bool m_failed{ false };
+
+		void Write_Buffer();
+
+	public:
+		explicit CBufferedFileWriter(const std::string& path, size_t bufferSize = DefaultBufferSize);
+		~CBufferedFileWriter();
+
+		CBufferedFileWriter(const CBufferedFileWriter&) = delete;
+		CBufferedFileWriter& operator=(const CBufferedFileWriter&) = delete;
+
+		bool Is_Open() const { return m_file != nullptr; }
+
+		// soubor se podarilo otevrit a nedoslo k chybe zapisu (plati i po Close)
+		bool Good() const { return !m_failed; }
+
+		// buffer pro primy zapis zaznamu (append*); po zapisu volat Commit
+		std::string& Buffer() { return m_buffer; }
+
+		// zapise buffer, pokud uz je plny
+		void Commit();
+
+		// prida data; velky blok (napr. usek naformatovany jinym vlaknem) jde rovnou do souboru
+		void Append(std::string_view data);
+
+		// zapise buffer a propise ho az do operacniho systemu (po kazde davce stranek)
+		void Flush();
+
+		// zapise zbytek a zavre soubor
+		void Close();
+};
+
+// Paralelni formatovani count polozek po blocich: kazdy blok se rozdeli na threads souvislych useku,
+// format(chunk, begin, end) je naformatuje soubezne (kazde vlakno do vlastniho Chunk) a consume(chunk) je pak
+// zpracuje postupne v puvodnim poradi - vystup je stejny jako pri sekvencnim formatovani.
+// Velikost bloku omezuje pamet bufferu nezavisle na poctu polozek.
+template <typename Chunk, typename Format, typename Consume>
+void formatParallel(size_t count, size_t threads, size_t blockSize, Format format, Consume consume) {
+	threads = std::max<size_t>(threads, 1);
+	blockSize = std::max(blockSize, threads);
+
+	std::vector<Chunk> chunks(threads);
+	std::vector<std::thread> workers;
+
+	for (size_t blockBegin = 0; blockBegin < count; blockBegin += blockSize) {
+		size_t blockEnd = std::min(count, blockBegin + blockSize);
+		size_t partSize = (blockEnd - blockBegin + threads - 1) / threads;
+
+		// prvni usek formatuje volajici vlakno
+		workers.clear();
+		for (size_t part = 1; part < threads; part++) {
+			size_t begin = std::min(blockEnd, blockBegin + part * partSize);
+			size_t end = std::min(blockEnd, begin + partSize);
+			if (begin < end) {
+				workers.emplace_back([&chunks, &format, part, begin, end]() { format(chunks[part], begin, end); });
+			}
+		}
+		format(chunks[0], blockBegin, std::min(blockEnd, blockBegin + partSize));
+		for (auto& worker : workers) {
+			worker.join();
+		}
+
+		for (size_t part = 0; part <= workers.size(); part++) {
+			consume(chunks[part]);
+		}
+	}
+}
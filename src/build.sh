@@ -1,3 +1,3 @@
 #!/bin/bash
 
-mpic++ -std=c++17 main.cpp server.cpp utils.cpp -o upp2
+mpic++ -std=c++20 -pthread main.cpp server.cpp utils.cpp html_scanner.cpp connection_pool.cpp pipeline.cpp work_stealing.cpp url_table.cpp visited_set.cpp crawl_frontier.cpp url_resolver.cpp page_message.cpp worker_group.cpp distributed_frontier.cpp page_batch_sender.cpp result_writer.cpp crawl_progress.cpp job_manager.cpp link_graph.cpp buffered_writer.cpp mapped_file.cpp page_archive.cpp recrawl_cache.cpp duplicate_index.cpp host_scheduler.cpp dns_cache.cpp result_store.cpp page_analyzer.cpp -o upp2
@@ -0,0 +1,140 @@
+/**
+ * Pool keep-alive spojeni pro stahovani stranek
+ */
+
+#ifdef USE_SSL
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#endif
+#include "../dep/cpp-httplib/httplib.h"
+
+#include "connection_pool.h"
+#include "dns_cache.h"
+
+namespace {
+	std::string makeKey(const std::string& scheme, const std::string& host) {
+		return scheme + "://" + host;
+	}
+}
+
+CConnectionPool::~CConnectionPool() = default;
+
+CConnectionPool& CConnectionPool::Instance() {
+	static CConnectionPool pool;
+	return pool;
+}
+
+void CConnectionPool::Configure(size_t maxIdlePerHost, std::chrono::steady_clock::duration idleTimeout) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_maxIdlePerHost = maxIdlePerHost;
+	m_idleTimeout = idleTimeout;
+
+	// orizne existujici fronty na novy limit
+	for (auto& [key, clients] : m_idle) {
+		if (clients.size() > m_maxIdlePerHost) {
+			size_t excess = clients.size() - m_maxIdlePerHost;
+			clients.erase(clients.begin(), clients.begin() + excess);
+			m_stats.evictions += excess;
+		}
+	}
+}
+
+void CConnectionPool::Evict_Expired(std::chrono::steady_clock::time_point now) {
+	for (auto it = m_idle.begin(); it != m_idle.end();) {
+		auto& clients = it->second;
+
+		// klienty jsou serazene podle casu vraceni, nejstarsi na zacatku
+		size_t expired = 0;
+		while (expired < clients.size() && now - clients[expired].lastUsed > m_idleTimeout) {
+			expired++;
+		}
+		clients.erase(clients.begin(), clients.begin() + expired);
+		m_stats.evictions += expired;
+
+		it = clients.empty() ? m_idle.erase(it) : std::next(it);
+	}
+	m_lastSweep = now;
+}
+
+std::unique_ptr<HttpClient> CConnectionPool::Acquire(const std::string& scheme, const std::string& host) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - m_lastSweep > m_idleTimeout) {
+			Evict_Expired(now);
+		}
+
+		auto it = m_idle.find(makeKey(scheme, host));
+		if (it != m_idle.end()) {
+			auto& clients = it->second;
+			// nejcerstvejsi spojeni ma nejvetsi sanci, ze ho server jeste nezavrel
+			while (!clients.empty()) {
+				IdleClient idle = std::move(clients.back());
+				clients.pop_back();
+
+				if (now - idle.lastUsed <= m_idleTimeout) {
+					m_stats.hits++;
+					return std::move(idle.client);
+				}
+				m_stats.evictions++;
+			}
+		}
+
+		m_stats.misses++;
+	}
+
+	// novy klient se vytvari mimo zamek
+#ifdef USE_SSL
+	auto client = std::make_unique<HttpClient>(host);
+	client->enable_server_certificate_verification(false);
+	client->enable_server_hostname_verification(false);
+#else
+	auto client = std::make_unique<HttpClient>(host);
+#endif
+
+	client->set_keep_alive(true);
+	client->set_follow_location(true);
+
+	// adresa z DNS cache - klient jinak preklada host pri kazdem novem spojeni;
+	// kdyz preklad selze, nechame ho na klientovi (chyba muze byt docasna)
+	std::string name = hostName(host);
+	std::string address = CDnsCache::Instance().Resolve(name);
+	if (!address.empty()) {
+		client->set_hostname_addr_map({ { name, address } });
+	}
+
+	return client;
+}
+
+void CConnectionPool::Release(const std::string& scheme, const std::string& host, std::unique_ptr<HttpClient> client) {
+	if (!client) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_maxIdlePerHost == 0) {
+		m_stats.evictions++;
+		return;
+	}
+
+	auto& clients = m_idle[makeKey(scheme, host)];
+	if (clients.size() >= m_maxIdlePerHost) {
+		// uvolni misto zavrenim nejstarsiho spojeni
+		clients.erase(clients.begin());
+		m_stats.evictions++;
+	}
+	clients.push_back({ std::move(client), std::chrono::steady_clock::now() });
+}
+
+CConnectionPool::Stats CConnectionPool::Get_Stats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Stats stats = m_stats;
+	stats.idle = 0;
+	for (const auto& [key, clients] : m_idle) {
+		stats.idle += clients.size();
+	}
+	return stats;
+}
@@ -0,0 +1,83 @@
+/**
+ * Pool keep-alive spojeni pro stahovani stranek
+ */
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+// dopredne deklarace
+namespace httplib {
+	class Client;
+	class SSLClient;
+}
+
+// stejny typ klienta, jaky pouziva utils::downloadHTML
+#ifdef USE_SSL
+using HttpClient = httplib::SSLClient;
+#else
+using HttpClient = httplib::Client;
+#endif
+
+// thread-safe pool klientu, klicem je schema + host (napr. "https://example.com")
+class CConnectionPool {
+	public:
+		// vychozi maximalni pocet necinnych spojeni na jeden host
+		static constexpr size_t DefaultMaxIdlePerHost = 4;
+		// vychozi doba, po ktere se necinne spojeni zavre
+		static constexpr std::chrono::seconds DefaultIdleTimeout{ 30 };
+
+		// citace pro vypis do logu
+		struct Stats {
+			size_t hits = 0;      // klient znovu pouzit z poolu
+			size_t misses = 0;    // musel byt vytvoren novy klient
+			size_t evictions = 0; // necinne klienty zavrene kvuli limitu nebo timeoutu
+			size_t idle = 0;      // aktualne necinne klienty v poolu
+		};
+
+	private:
+		struct IdleClient {
+			std::unique_ptr<HttpClient> client;
+			std::chrono::steady_clock::time_point lastUsed;
+		};
+
+		mutable std::mutex m_mutex;
+
+		// necinne klienty podle klice schema + host, posledni vlozeny je na konci
+		std::unordered_map<std::string, std::vector<IdleClient>> m_idle;
+
+		size_t m_maxIdlePerHost{ DefaultMaxIdlePerHost };
+		std::chrono::steady_clock::duration m_idleTimeout{ DefaultIdleTimeout };
+		std::chrono::steady_clock::time_point m_lastSweep{ std::chrono::steady_clock::now() };
+
+		Stats m_stats;
+
+		// zavre necinne klienty starsi nez m_idleTimeout; volat se zamcenym m_mutex
+		void Evict_Expired(std::chrono::steady_clock::time_point now);
+
+	public:
+		~CConnectionPool();
+
+		// sdilena instance pro cely proces
+		static CConnectionPool& Instance();
+
+		// nastaveni limitu; maxIdlePerHost == 0 vypne znovupouziti spojeni
+		void Configure(size_t maxIdlePerHost, std::chrono::steady_clock::duration idleTimeout);
+
+		// vrati klienta pro dany host - necinny z poolu, nebo novy
+		// scheme - "http" nebo "https"
+		// host - domena (pripadne s portem)
+		std::unique_ptr<HttpClient> Acquire(const std::string& scheme, const std::string& host);
+
+		// vrati klienta do poolu po uspesnem pozadavku; klienty po chybe se nevraceji, jen se zahodi
+		void Release(const std::string& scheme, const std::string& host, std::unique_ptr<HttpClient> client);
+
+		// aktualni hodnoty citacu
+		Stats Get_Stats() const;
+};
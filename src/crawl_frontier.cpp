@@ -0,0 +1,117 @@
+/**
+ * Fronta URL ke zpracovani spolecne s mnozinou navstivenych URL pro jednu domenu
+ */
+
+#include "crawl_frontier.h"
+
+namespace {
+	// odhad poctu URL jedne domeny, pokud ho volajici nezada
+	constexpr size_t DefaultExpectedUrls = 4096;
+
+	CFingerprintSet::Config fingerprintConfig(VisitedSetMode mode, size_t expectedUrls) {
+		CFingerprintSet::Config config;
+		// v rezimu Exact se tabulka otisku nepouziva, staci minimalni velikost;
+		// jinak bez odhadu zacneme s mensi tabulkou (roste sama), Bloomuv filtr je ale dimenzovan jen na tento pocet
+		if (mode == VisitedSetMode::Exact) {
+			config.expectedUrls = 0;
+		}
+		else if (expectedUrls > 0) {
+			config.expectedUrls = expectedUrls;
+		}
+		else {
+			config.expectedUrls = DefaultExpectedUrls;
+		}
+		config.useBloomFilter = (mode == VisitedSetMode::FingerprintBloom);
+		return config;
+	}
+}
+
+CCrawlFrontier::CCrawlFrontier(VisitedSetMode mode, size_t expectedUrls)
+	: m_mode{ mode },
+	  m_urls{ mode == VisitedSetMode::Exact ? expectedUrls : 0 },
+	  m_fingerprints{ fingerprintConfig(mode, expectedUrls) } {
+}
+
+bool CCrawlFrontier::Push_If_New(std::string_view url) {
+	if (m_mode == VisitedSetMode::Exact) {
+		auto [id, inserted] = m_urls.Intern(url);
+		if (inserted) {
+			m_queuedIds.push(id);
+		}
+		return inserted;
+	}
+
+	if (!m_fingerprints.Insert(url)) {
+		return false;
+	}
+	m_queuedUrls.emplace(url);
+	return true;
+}
+
+bool CCrawlFrontier::Contains(std::string_view url) const {
+	if (m_mode == VisitedSetMode::Exact) {
+		return m_urls.Contains(url);
+	}
+	return m_fingerprints.Contains(url);
+}
+
+bool CCrawlFrontier::Empty() const {
+	return m_mode == VisitedSetMode::Exact ? m_queuedIds.empty() : m_queuedUrls.empty();
+}
+
+size_t CCrawlFrontier::Queued() const {
+	return m_mode == VisitedSetMode::Exact ? m_queuedIds.size() : m_queuedUrls.size();
+}
+
+std::string CCrawlFrontier::Pop() {
+	if (m_mode == VisitedSetMode::Exact) {
+		std::string url = m_urls.Materialize(m_queuedIds.front());
+		m_queuedIds.pop();
+		return url;
+	}
+
+	std::string url = std::move(m_queuedUrls.front());
+	m_queuedUrls.pop();
+	return url;
+}
+
+size_t CCrawlFrontier::Visited_Count() const {
+	return m_mode == VisitedSetMode::Exact ? m_urls.Size() : m_fingerprints.Size();
+}
+
+size_t CCrawlFrontier::Visited_Memory_Usage() const {
+	return m_mode == VisitedSetMode::Exact ? m_urls.Memory_Usage() : m_fingerprints.Memory_Usage();
+}
+
+void CCrawlFrontier::Print_Queue(std::ostream& os) const {
+	int index = 1;
+	if (m_mode == VisitedSetMode::Exact) {
+		std::queue<UrlId> queued = m_queuedIds;
+		while (!queued.empty()) {
+			os << "[" << index++ << "] " << m_urls.View(queued.front()) << std::endl;
+			queued.pop();
+		}
+	}
+	else {
+		std::queue<std::string> queued = m_queuedUrls;
+		while (!queued.empty()) {
+			os << "[" << index++ << "] " << queued.front() << std::endl;
+			queued.pop();
+		}
+	}
+}
+
+void CCrawlFrontier::Print_Stats(std::ostream& os) const {
+	size_t count = Visited_Count();
+	size_t memory = Visited_Memory_Usage();
+	os << "Navštívené URL: " << count << ", " << memory << " B (" << (count ? memory / count : 0) << " B/URL)";
+
+	if (m_mode != VisitedSetMode::Exact) {
+		CFingerprintSet::Stats stats = m_fingerprints.Get_Stats();
+		os << ", dotazů " << stats.lookups << ", pravděpodobnost kolize otisků " << stats.expectedCollisionRate;
+		if (m_mode == VisitedSetMode::FingerprintBloom) {
+			os << ", Bloom: jistě nových " << stats.bloomNegatives << ", falešně pozitivních " << stats.bloomFalsePositives;
+		}
+	}
+	os << std::endl;
+}
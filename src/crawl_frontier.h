@@ -0,0 +1,62 @@
+/**
+ * Fronta URL ke zpracovani spolecne s mnozinou navstivenych URL pro jednu domenu
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <queue>
+#include <ostream>
+
+#include "url_table.h"
+#include "visited_set.h"
+
+// zpusob ukladani navstivenych URL
+enum class VisitedSetMode {
+	Exact,            // CUrlTable - presne, kazda URL ulozena jednou, fronta obsahuje jen ID
+	Fingerprint,      // CFingerprintSet - jen 64bitove otisky, fronta drzi text URL do jejiho zpracovani
+	FingerprintBloom  // CFingerprintSet s Bloomovym filtrem pred tabulkou otisku
+};
+
+class CCrawlFrontier {
+	private:
+		VisitedSetMode m_mode;
+
+		// rezim Exact
+		CUrlTable m_urls;
+		std::queue<UrlId> m_queuedIds;
+
+		// rezimy Fingerprint a FingerprintBloom
+		CFingerprintSet m_fingerprints;
+		std::queue<std::string> m_queuedUrls;
+
+	public:
+		explicit CCrawlFrontier(VisitedSetMode mode, size_t expectedUrls = 0);
+
+		// prida URL do fronty, pokud jeste nebyla navstivena; vraci true, pokud byla pridana
+		bool Push_If_New(std::string_view url);
+
+		// URL uz byla videna (je ve fronte nebo zpracovana)
+		bool Contains(std::string_view url) const;
+
+		bool Empty() const;
+
+		// pocet URL cekajicich ve fronte
+		size_t Queued() const;
+
+		// vyjme dalsi URL z fronty
+		std::string Pop();
+
+		// pocet vsech dosud videnych URL
+		size_t Visited_Count() const;
+
+		// pamet mnoziny navstivenych URL v bajtech
+		size_t Visited_Memory_Usage() const;
+
+		// vypise cekajici URL ve formatu "[poradi] URL"
+		void Print_Queue(std::ostream& os) const;
+
+		// souhrn pro log (pocet URL, bajty na URL, statistiky Bloomova filtru)
+		void Print_Stats(std::ostream& os) const;
+};
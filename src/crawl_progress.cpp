@@ -0,0 +1,56 @@
+/**
+ * Prubeh probihajiciho obchodu - zapisuje crawler (master), cte server pro prubezne hlaseni klientovi
+ */
+
+#include "crawl_progress.h"
+
+CCrawlProgress& CCrawlProgress::Instance() {
+	static CCrawlProgress progress;
+	return progress;
+}
+
+void CCrawlProgress::Start(size_t domainsTotal) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_domainsTotal = domainsTotal;
+	m_domainsDone = 0;
+	m_pagesDone = 0;
+	m_queueDepth = 0;
+	m_running = true;
+	m_start = std::chrono::steady_clock::now();
+}
+
+void CCrawlProgress::Pages_Done(size_t count) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pagesDone += count;
+}
+
+void CCrawlProgress::Set_Queue_Depth(size_t depth) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_queueDepth = depth;
+}
+
+void CCrawlProgress::Domain_Done() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_domainsDone++;
+}
+
+void CCrawlProgress::Finish() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_queueDepth = 0;
+	m_running = false;
+}
+
+CCrawlProgress::Snapshot CCrawlProgress::Get() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Snapshot snapshot;
+	snapshot.domainsTotal = m_domainsTotal;
+	snapshot.domainsDone = m_domainsDone;
+	snapshot.pagesDone = m_pagesDone;
+	snapshot.queueDepth = m_queueDepth;
+	snapshot.running = m_running;
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+	snapshot.pagesPerSecond = seconds > 0 ? m_pagesDone / seconds : 0;
+	return snapshot;
+}
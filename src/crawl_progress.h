@@ -0,0 +1,47 @@
+/**
+ * Prubeh probihajiciho obchodu - zapisuje crawler (master), cte server pro prubezne hlaseni klientovi
+ */
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+
+// thread-safe citace jednoho obchodu (jednoho odeslani formulare)
+class CCrawlProgress {
+	public:
+		struct Snapshot {
+			size_t domainsTotal = 0;
+			size_t domainsDone = 0;
+			size_t pagesDone = 0;
+			size_t queueDepth = 0;      // URL cekajici ve frontach (posledni hlaseni od Worker A)
+			double pagesPerSecond = 0;  // prumer od Start
+			bool running = false;
+		};
+
+	private:
+		mutable std::mutex m_mutex;
+
+		size_t m_domainsTotal{ 0 };
+		size_t m_domainsDone{ 0 };
+		size_t m_pagesDone{ 0 };
+		size_t m_queueDepth{ 0 };
+		bool m_running{ false };
+		std::chrono::steady_clock::time_point m_start{ std::chrono::steady_clock::now() };
+
+	public:
+		// sdilena instance pro cely proces
+		static CCrawlProgress& Instance();
+
+		// vynuluje citace pred novym obchodem
+		void Start(size_t domainsTotal);
+
+		void Pages_Done(size_t count);
+		void Set_Queue_Depth(size_t depth);
+		void Domain_Done();
+
+		void Finish();
+
+		Snapshot Get() const;
+};
@@ -0,0 +1,147 @@
+/**
+ * Fronta a mnozina navstivenych URL jedne domeny rozdelena mezi Worker A podle hashe URL
+ */
+
+#include "distributed_frontier.h"
+#include "mpi_protocol.h"
+#include "page_message.h"
+#include "visited_set.h"
+
+CDistributedFrontier::CDistributedFrontier(int myRank, int numWorkerA, VisitedSetMode mode, size_t batchSize)
+	: m_rank{ myRank }, m_numWorkerA{ numWorkerA }, m_batchSize{ batchSize > 0 ? batchSize : 1 }, m_local(mode) {
+	m_outgoing.resize(numWorkerA);
+}
+
+CDistributedFrontier::~CDistributedFrontier() {
+	Wait_Sends();
+}
+
+int CDistributedFrontier::Owner(std::string_view url) const {
+	// otisk je FNV-1a nezavisly na procesu, vsechny Worker A tedy urci stejneho vlastnika
+	return static_cast<int>(CFingerprintSet::Fingerprint(url) % static_cast<uint64_t>(m_numWorkerA)) + 1;
+}
+
+void CDistributedFrontier::Add(std::string_view url) {
+	int owner = Owner(url);
+	if (owner == m_rank) {
+		m_local.Push_If_New(url);
+		return;
+	}
+
+	auto& batch = m_outgoing[owner - 1];
+	batch.emplace_back(url);
+	m_urlsForwarded++;
+	if (batch.size() >= m_batchSize) {
+		Send_Batch(owner);
+	}
+}
+
+void CDistributedFrontier::Send_Batch(int owner) {
+	auto& batch = m_outgoing[owner - 1];
+
+	PendingSend& send = m_sends.emplace_back();
+	encodeUrls(batch, send.buffer);
+	MPI_Isend(send.buffer.data(), static_cast<int>(send.buffer.size()), MPI_CHAR, owner, URL_BATCH, MPI_COMM_WORLD, &send.request);
+
+	batch.clear();
+	m_batchesSent++;
+}
+
+void CDistributedFrontier::Flush() {
+	for (int owner = 1; owner <= m_numWorkerA; owner++) {
+		if (!m_outgoing[owner - 1].empty()) {
+			Send_Batch(owner);
+		}
+	}
+	Complete_Sends();
+}
+
+void CDistributedFrontier::Receive_Batch(MPI_Status& probed) {
+	int size;
+	MPI_Get_count(&probed, MPI_CHAR, &size);
+	std::vector<char> buffer(size);
+	MPI_Recv(buffer.data(), size, MPI_CHAR, probed.MPI_SOURCE, URL_BATCH, MPI_COMM_WORLD, &probed);
+	m_batchesReceived++;
+
+	if (!decodeUrls(buffer.data(), buffer.size(), m_received)) {
+		return;
+	}
+	for (const auto& url : m_received) {
+		m_local.Push_If_New(url);
+	}
+}
+
+void CDistributedFrontier::Complete_Sends() {
+	// davky se dokoncuji priblizne v poradi odeslani, staci kontrolovat zacatek fronty
+	while (!m_sends.empty()) {
+		int done = 0;
+		MPI_Test(&m_sends.front().request, &done, MPI_STATUS_IGNORE);
+		if (!done) {
+			break;
+		}
+		m_sends.pop_front();
+	}
+}
+
+void CDistributedFrontier::Wait_Sends() {
+	for (auto& send : m_sends) {
+		MPI_Wait(&send.request, MPI_STATUS_IGNORE);
+	}
+	m_sends.clear();
+}
+
+void CDistributedFrontier::Print_Stats(std::ostream& os) const {
+	m_local.Print_Stats(os);
+	os << "  forwarded " << m_urlsForwarded << " URLs in " << m_batchesSent << " batches, received "
+	   << m_batchesReceived << " batches" << std::endl;
+}
+
+void waitForDistributedTermination(int numWorkerA, const std::function<void(MPI_Status&)>& onOtherMessage) {
+	bool havePrevious = false;
+	uint64_t previousSent = 0;
+	uint64_t previousReceived = 0;
+
+	for (int wave = 0;; wave++) {
+		for (int workerA = 1; workerA <= numWorkerA; workerA++) {
+			MPI_Send(&wave, 1, MPI_INT, workerA, TERMINATION_PROBE, MPI_COMM_WORLD);
+		}
+
+		uint64_t sent = 0;
+		uint64_t received = 0;
+		for (int reports = 0; reports < numWorkerA;) {
+			// Worker A muze pred odpovedi blokovat v MPI_Send jine zpravy mastrovi - ty je nutne prijimat prubezne
+			MPI_Status probed;
+			MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probed);
+			if (probed.MPI_TAG != TERMINATION_REPORT) {
+				onOtherMessage(probed);
+				continue;
+			}
+
+			uint64_t counters[2];
+			MPI_Recv(counters, 2, MPI_UINT64_T, probed.MPI_SOURCE, TERMINATION_REPORT, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+			reports++;
+			sent += counters[0];
+			received += counters[1];
+		}
+
+		// vsechny Worker A byly v obou vlnach necinne a mezi vlnami se zadna davka neodeslala ani neprijala
+		if (havePrevious && sent == received && sent == previousSent && received == previousReceived) {
+			break;
+		}
+
+		havePrevious = true;
+		previousSent = sent;
+		previousReceived = received;
+	}
+
+	// vlna -1 = konec domeny
+	int finished = -1;
+	for (int workerA = 1; workerA <= numWorkerA; workerA++) {
+		MPI_Send(&finished, 1, MPI_INT, workerA, TERMINATION_PROBE, MPI_COMM_WORLD);
+	}
+}
+
+void reportTerminationCounters(const CDistributedFrontier& frontier) {
+	uint64_t counters[2] = { frontier.Batches_Sent(), frontier.Batches_Received() };
+	MPI_Send(counters, 2, MPI_UINT64_T, 0, TERMINATION_REPORT, MPI_COMM_WORLD);
+}
@@ -0,0 +1,92 @@
+/**
+ * Fronta a mnozina navstivenych URL jedne domeny rozdelena mezi Worker A podle hashe URL
+ *
+ * Kazda URL ma jedineho vlastnika (rank Worker A). Jen vlastnik ji ma ve sve mnozine navstivenych URL a ve fronte;
+ * ostatni Worker A mu nalezene URL posilaji v davkach (URL_BATCH). Konec obchodu zjistuje master vlnami
+ * dotazu na citace odeslanych a prijatych davek (pocitani ve dvou vlnach podle Matterna).
+ */
+
+#pragma once
+
+#include <mpi.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <ostream>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "crawl_frontier.h"
+
+class CDistributedFrontier {
+	private:
+		// odeslana davka; buffer musi zustat platny do dokonceni MPI_Isend
+		struct PendingSend {
+			std::vector<char> buffer;
+			MPI_Request request;
+		};
+
+		int m_rank;
+		int m_numWorkerA;
+		size_t m_batchSize;
+
+		CCrawlFrontier m_local;
+
+		// rozpracovane davky pro ostatni Worker A (index = rank - 1)
+		std::vector<std::vector<std::string>> m_outgoing;
+		std::deque<PendingSend> m_sends;
+		std::vector<std::string> m_received;
+
+		uint64_t m_batchesSent{ 0 };
+		uint64_t m_batchesReceived{ 0 };
+		uint64_t m_urlsForwarded{ 0 };
+
+		void Send_Batch(int owner);
+
+	public:
+		// batchSize - po kolika URL se davka pro jednoho vlastnika odesle hned (jinak az pri Flush)
+		CDistributedFrontier(int myRank, int numWorkerA, VisitedSetMode mode, size_t batchSize);
+		~CDistributedFrontier();
+
+		// rank Worker A, ktery URL vlastni; stejny vysledek na vsech procesech
+		int Owner(std::string_view url) const;
+
+		// URL vlastni tento Worker A - prida se do lokalni fronty, pokud je nova; jinak se prida do davky pro vlastnika
+		void Add(std::string_view url);
+
+		// URL patrici tomuto Worker A uz byla videna (o URL ostatnich Worker A nevi)
+		bool Contains(std::string_view url) const { return m_local.Contains(url); }
+
+		bool Empty() const { return m_local.Empty(); }
+		std::string Pop() { return m_local.Pop(); }
+		size_t Queued() const { return m_local.Queued(); }
+
+		// odesle vsechny neprazdne davky (pred cekanim na zpravy a pred hlasenim necinnosti)
+		void Flush();
+
+		// prijme davku URL (zprava URL_BATCH zjistena pres MPI_Probe) a nove URL zaradi do fronty
+		void Receive_Batch(MPI_Status& probed);
+
+		// uvolni buffery dokoncenych odesilani; Wait_Sends ceka na vsechna
+		void Complete_Sends();
+		void Wait_Sends();
+
+		uint64_t Batches_Sent() const { return m_batchesSent; }
+		uint64_t Batches_Received() const { return m_batchesReceived; }
+
+		// souhrn pro log: vlastni URL, preposlane URL, davky
+		void Print_Stats(std::ostream& os) const;
+};
+
+// master: ceka, az vsechny Worker A budou necinne a zadna davka URL nebude na ceste.
+// Kazda vlna posle vsem Worker A TERMINATION_PROBE; Worker A odpovi (TERMINATION_REPORT) az ve chvili, kdy je necinny.
+// Konec nastal, pokud dve po sobe jdouci vlny nahlasi stejne citace a odeslanych davek je stejne jako prijatych;
+// pak master posle vsem Worker A vlnu -1.
+// Ostatni zpravy, ktere behem cekani dorazi (napr. prubezne davky stranek), preda onOtherMessage - musi je prijmout.
+void waitForDistributedTermination(int numWorkerA, const std::function<void(MPI_Status&)>& onOtherMessage);
+
+// Worker A: odpoved na vlnu TERMINATION_PROBE s aktualnimi citaci
+void reportTerminationCounters(const CDistributedFrontier& frontier);
@@ -0,0 +1,189 @@
+/**
+ * Cache prekladu jmen hostitelu s prekladem na pozadi
+ */
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#endif
+
+#include "dns_cache.h"
+
+std::string hostName(std::string_view authority) {
+	size_t at = authority.rfind('@');
+	if (at != std::string_view::npos) {
+		authority.remove_prefix(at + 1);
+	}
+	if (!authority.empty() && authority.front() == '[') {
+		size_t close = authority.find(']');
+		return std::string(authority.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1));
+	}
+	return std::string(authority.substr(0, authority.find(':')));
+}
+
+CDnsCache& CDnsCache::Instance() {
+	static CDnsCache cache;
+	return cache;
+}
+
+CDnsCache::~CDnsCache() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_work.notify_all();
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+}
+
+std::string CDnsCache::Lookup(const std::string& host) {
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	addrinfo* result = nullptr;
+	if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+		return "";
+	}
+
+	char address[INET6_ADDRSTRLEN] = {};
+	const void* raw = result->ai_family == AF_INET6
+		? static_cast<const void*>(&reinterpret_cast<const sockaddr_in6*>(result->ai_addr)->sin6_addr)
+		: static_cast<const void*>(&reinterpret_cast<const sockaddr_in*>(result->ai_addr)->sin_addr);
+	bool converted = inet_ntop(result->ai_family, raw, address, sizeof(address)) != nullptr;
+	freeaddrinfo(result);
+	return converted ? address : "";
+}
+
+std::string CDnsCache::Resolve_And_Store(const std::string& host, bool prefetch) {
+	Clock::time_point start = Clock::now();
+	std::string address = Lookup(host);
+	Clock::time_point end = Clock::now();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Entry& entry = m_entries[host];
+	entry.address = address;
+	entry.expires = end + (address.empty() ? NegativeTtl : DefaultTtl);
+	entry.resolving = false;
+	entry.refreshing = false;
+	entry.prefetched = prefetch;
+
+	m_stats.resolves++;
+	m_stats.resolveTime += end - start;
+	if (address.empty()) {
+		m_stats.failures++;
+	}
+	if (prefetch) {
+		m_stats.prefetches++;
+	}
+	m_resolved.notify_all();
+	return address;
+}
+
+bool CDnsCache::Enqueue_Locked(const std::string& host) {
+	if (m_stopping || m_pending.size() >= MaxPendingPrefetches) {
+		return false;
+	}
+	m_pending.push_back(host);
+	// vlakna resolveru se spousti az s prvnim prekladem na pozadi (Worker B bez Prefetch je nepotrebuje)
+	if (m_threads.empty()) {
+		for (size_t i = 0; i < ResolverThreads; i++) {
+			m_threads.emplace_back(&CDnsCache::Resolver_Thread, this);
+		}
+	}
+	m_work.notify_one();
+	return true;
+}
+
+void CDnsCache::Resolver_Thread() {
+	while (true) {
+		std::string host;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_work.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+			if (m_stopping) {
+				return;
+			}
+			host = std::move(m_pending.front());
+			m_pending.pop_front();
+
+			// mezitim ho mohl prelozit Resolve
+			Entry& entry = m_entries[host];
+			if (entry.resolving || (!entry.refreshing && Clock::now() < entry.expires)) {
+				continue;
+			}
+			// pri obnove plati stara adresa dal - Resolve na ni neceka
+			if (!entry.refreshing) {
+				entry.resolving = true;
+			}
+		}
+		Resolve_And_Store(host, true);
+	}
+}
+
+std::string CDnsCache::Resolve(const std::string& host) {
+	if (host.empty()) {
+		return "";
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(host);
+	if (it != m_entries.end()) {
+		Entry& entry = it->second;
+		// preklad uz bezi na pozadi - staci na nej pockat
+		m_resolved.wait(lock, [&entry] { return !entry.resolving; });
+
+		Clock::time_point now = Clock::now();
+		if (now < entry.expires) {
+			m_stats.hits++;
+			if (entry.prefetched) {
+				m_stats.prefetchHits++;
+				entry.prefetched = false;
+			}
+			Clock::duration ttl = entry.address.empty() ? Clock::duration(NegativeTtl) : Clock::duration(DefaultTtl);
+			if (!entry.refreshing && entry.expires - now < std::chrono::duration_cast<Clock::duration>(ttl * RefreshFraction)) {
+				entry.refreshing = Enqueue_Locked(host);
+			}
+			return entry.address;
+		}
+		entry.resolving = true;
+	} else {
+		m_entries[host].resolving = true;
+	}
+	m_stats.misses++;
+	lock.unlock();
+
+	return Resolve_And_Store(host, false);
+}
+
+void CDnsCache::Prefetch(const std::string& host) {
+	if (host.empty()) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(host);
+	if (it != m_entries.end() && (it->second.resolving || Clock::now() < it->second.expires)) {
+		return;
+	}
+	Enqueue_Locked(host);
+}
+
+CDnsCache::Stats CDnsCache::Get_Stats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+void CDnsCache::Print_Stats(std::ostream& os) const {
+	Stats stats = Get_Stats();
+	long long averageUs = stats.resolves == 0 ? 0
+		: std::chrono::duration_cast<std::chrono::microseconds>(stats.resolveTime).count() / static_cast<long long>(stats.resolves);
+	os << "DNS cache: zásahů " << stats.hits << " (z předběžného překladu " << stats.prefetchHits << "), nepřeloženo " << stats.misses
+	   << ", přeloženo na pozadí " << stats.prefetches << ", chyb " << stats.failures
+	   << ", průměrný překlad " << averageUs << " us" << std::endl;
+}
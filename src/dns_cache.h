@@ -0,0 +1,100 @@
+/**
+ * Cache prekladu jmen hostitelu pro cely proces - novy klient v CConnectionPool nemusi pri kazdem
+ * pripojeni cekat na resolver
+ *
+ * getaddrinfo nevraci TTL zaznamu, proto uspesny preklad plati DefaultTtl a neuspesny NegativeTtl.
+ * Zaznam, kteremu zbyva mene nez RefreshFraction platnosti, se pri pouziti obnovi na pozadi - bezici
+ * crawl na vyprseni zaznamu neceka. Prefetch preklada hostitele dopredu na vlaknech resolveru,
+ * Resolve na rozpracovany preklad jen pocka.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+
+// jmeno hostitele z autority URL - bez uzivatele, portu a hranatych zavorek IPv6
+std::string hostName(std::string_view authority);
+
+class CDnsCache {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::chrono::seconds DefaultTtl{ 300 };
+		static constexpr std::chrono::seconds NegativeTtl{ 30 };
+		static constexpr double RefreshFraction = 0.1;
+		static constexpr size_t ResolverThreads = 2;
+		// dalsi Prefetch se pri plne fronte zahodi - hostitel se prelozi az pri pouziti
+		static constexpr size_t MaxPendingPrefetches = 256;
+
+		struct Stats {
+			size_t hits = 0;           // platny zaznam v cache
+			size_t prefetchHits = 0;   // z nich prvni pouziti zaznamu z Prefetch
+			size_t misses = 0;         // Resolve musel prekladat sam
+			size_t prefetches = 0;     // preklady na pozadi (Prefetch a obnova pred vyprsenim)
+			size_t failures = 0;       // neuspesne preklady
+			size_t resolves = 0;       // vsechny preklady (getaddrinfo)
+			Clock::duration resolveTime{};
+		};
+
+	private:
+		struct Entry {
+			// ciselna adresa; prazdna = hostitel nejde prelozit
+			std::string address;
+			Clock::time_point expires{};
+			bool resolving = false;
+			// obnova pred vyprsenim je ve fronte - do jejiho dokonceni plati stara adresa
+			bool refreshing = false;
+			// zaznam z Prefetch, ktery jeste nikdo nepouzil
+			bool prefetched = false;
+		};
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_resolved;
+		std::condition_variable m_work;
+		std::unordered_map<std::string, Entry> m_entries;
+		std::deque<std::string> m_pending;
+		std::vector<std::thread> m_threads;
+		bool m_stopping{ false };
+		Stats m_stats;
+
+		CDnsCache() = default;
+
+		// getaddrinfo; prazdny retezec pri chybe
+		static std::string Lookup(const std::string& host);
+
+		// prelozi hostitele (zaznam uz je oznaceny resolving) a ulozi vysledek; m_mutex musi byt odemceny
+		std::string Resolve_And_Store(const std::string& host, bool prefetch);
+
+		// zaradi hostitele k prekladu na pozadi; false = fronta je plna; volat se zamcenym m_mutex
+		bool Enqueue_Locked(const std::string& host);
+
+		void Resolver_Thread();
+
+	public:
+		static CDnsCache& Instance();
+		~CDnsCache();
+
+		CDnsCache(const CDnsCache&) = delete;
+		CDnsCache& operator=(const CDnsCache&) = delete;
+
+		// ciselna adresa hostitele (z cache, nebo po prekladu); prazdny retezec, pokud hostitel nejde prelozit
+		std::string Resolve(const std::string& host);
+
+		// prelozi hostitele na pozadi, pokud neni v cache; nikdy neblokuje
+		void Prefetch(const std::string& host);
+
+		Stats Get_Stats() const;
+
+		// souhrn pro log
+		void Print_Stats(std::ostream& os) const;
+};
@@ -0,0 +1,217 @@
+/**
+ * Hledani duplicitnich stranek - presny hash HTML a SimHash textu
+ */
+
+#include "duplicate_index.h"
+
+#include <bit>
+#include <array>
+
+namespace {
+	constexpr uint64_t FnvOffset = 14695981039346656037ULL;
+	constexpr uint64_t FnvPrime = 1099511628211ULL;
+
+	// finalizer z MurmurHash3 - rozprostre bity FNV hashe
+	uint64_t mix64(uint64_t x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return x;
+	}
+
+	// znaky slov bez locale (std::isalnum na kazdy bajt je pomale); bajty >= 0x80 jsou casti UTF-8 znaku -
+	// bereme je jako pismena
+	constexpr std::array<bool, 256> WordChars = [] {
+		std::array<bool, 256> table{};
+		for (int c = 0; c < 256; c++) {
+			table[c] = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+		}
+		return table;
+	}();
+
+	bool isWordChar(unsigned char c) {
+		return WordChars[c];
+	}
+
+	unsigned char asciiLower(unsigned char c) {
+		return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+	}
+
+	// html[pos] == '<'; vrati pozici za znackou, u <script> a <style> az za jejich koncovou znackou
+	size_t skipTag(std::string_view html, size_t pos) {
+		auto startsWith = [&html](size_t at, std::string_view name) {
+			if (html.size() - at < name.size()) {
+				return false;
+			}
+			for (size_t i = 0; i < name.size(); i++) {
+				if (asciiLower(static_cast<unsigned char>(html[at + i])) != name[i]) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		constexpr std::string_view RawTags[][2] = { { "script", "</script" }, { "style", "</style" } };
+		for (const auto& [raw, closing] : RawTags) {
+			if (startsWith(pos + 1, raw)) {
+				for (size_t at = html.find('<', pos + 1); at != std::string_view::npos; at = html.find('<', at + 1)) {
+					if (startsWith(at, closing)) {
+						pos = at;
+						break;
+					}
+				}
+				break;
+			}
+		}
+
+		size_t end = html.find('>', pos);
+		return end == std::string_view::npos ? html.size() : end + 1;
+	}
+}
+
+uint64_t contentHash(std::string_view html) {
+	if (html.empty()) {
+		return 0;
+	}
+	uint64_t hash = FnvOffset;
+	for (char c : html) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= FnvPrime;
+	}
+	return mix64(hash);
+}
+
+uint64_t simHash(std::string_view html) {
+	// hlasovani bitu: misto 64 pricteni na shingle se jednicky scitaji po bajtech - lanes[k] ma v bajtu j
+	// pocet shinglu s jednickou v bitu 8 * j + k. Bajt pojme nejvys 255 shinglu, pak se preleje do ones
+	constexpr uint64_t LowBits = 0x0101010101010101ULL;
+	constexpr size_t LaneLimit = 255;
+	uint64_t lanes[8] = {};
+	size_t inLanes = 0;
+	uint64_t ones[64] = {};
+	auto flush = [&lanes, &ones, &inLanes] {
+		for (int k = 0; k < 8; k++) {
+			for (int j = 0; j < 8; j++) {
+				ones[8 * j + k] += (lanes[k] >> (8 * j)) & 0xff;
+			}
+			lanes[k] = 0;
+		}
+		inLanes = 0;
+	};
+	size_t shingles = 0;
+	// hashe poslednich dvou slov
+	uint64_t previous[2] = { 0, 0 };
+	size_t words = 0;
+
+	size_t pos = 0;
+	while (pos < html.size()) {
+		unsigned char c = static_cast<unsigned char>(html[pos]);
+		if (c == '<') {
+			pos = skipTag(html, pos);
+			continue;
+		}
+		if (!isWordChar(c)) {
+			pos++;
+			continue;
+		}
+
+		uint64_t word = FnvOffset;
+		while (pos < html.size() && isWordChar(static_cast<unsigned char>(html[pos]))) {
+			word ^= asciiLower(static_cast<unsigned char>(html[pos]));
+			word *= FnvPrime;
+			pos++;
+		}
+
+		if (++words >= 3) {
+			uint64_t shingle = mix64(previous[0] * 31 * 31 + previous[1] * 31 + word);
+			for (int k = 0; k < 8; k++) {
+				lanes[k] += (shingle >> k) & LowBits;
+			}
+			if (++inLanes == LaneLimit) {
+				flush();
+			}
+			shingles++;
+		}
+		previous[0] = previous[1];
+		previous[1] = word;
+	}
+
+	if (shingles < CDuplicateIndex::MinSimHashShingles) {
+		return 0;
+	}
+	flush();
+	// bit je 1, pokud jednicky prevazi nuly
+	uint64_t result = 0;
+	for (int bit = 0; bit < 64; bit++) {
+		if (ones[bit] * 2 > shingles) {
+			result |= 1ULL << bit;
+		}
+	}
+	return result;
+}
+
+std::optional<std::string> CDuplicateIndex::Find_Or_Add(const PageAnalysisResult& page) {
+	// nestazena stranka (Worker B posila i prazdne vysledky) neni duplicitou niceho
+	if (page.contentHash == 0) {
+		return std::nullopt;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto exact = m_exact.find(page.contentHash);
+	if (exact != m_exact.end()) {
+		m_stats.exactDuplicates++;
+		return m_urls[exact->second];
+	}
+
+	auto bandOf = [](uint64_t hash, int band) { return (hash >> (band * BandBits)) & ((1ULL << BandBits) - 1); };
+
+	if (page.simHash != 0) {
+		for (int band = 0; band < Bands; band++) {
+			auto [first, last] = m_bands[band].equal_range(bandOf(page.simHash, band));
+			for (auto it = first; it != last; ++it) {
+				if (std::popcount(m_simHashes[it->second] ^ page.simHash) <= NearDuplicateBits) {
+					m_stats.nearDuplicates++;
+					return m_urls[it->second];
+				}
+			}
+		}
+	}
+
+	uint32_t index = static_cast<uint32_t>(m_urls.size());
+	m_urls.push_back(page.url);
+	m_simHashes.push_back(page.simHash);
+	m_exact.emplace(page.contentHash, index);
+	if (page.simHash != 0) {
+		for (int band = 0; band < Bands; band++) {
+			m_bands[band].emplace(bandOf(page.simHash, band), index);
+		}
+	}
+	return std::nullopt;
+}
+
+void CDuplicateIndex::Skip_Links(const PageAnalysisResult& page, const std::function<bool(const std::string&)>& isNew) {
+	size_t newUrls = 0;
+	for (const std::string& url : page.foundUrls) {
+		if (isNew(url)) {
+			newUrls++;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.skippedLinks += page.foundUrls.size();
+	m_stats.avoidedFetches += newUrls;
+}
+
+CDuplicateIndex::Stats CDuplicateIndex::Get_Stats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+void makeAlias(PageAnalysisResult& page, std::string canonicalUrl) {
+	page.aliasOf = std::move(canonicalUrl);
+	page.headers = {};
+	page.foundUrls = {};
+}
@@ -0,0 +1,73 @@
+/**
+ * Hledani duplicitnich stranek v ramci obchodu jedne domeny - presna kopie podle hashe HTML
+ * a tema podle SimHash textu stranky (stejny obsah pod jinou URL: session parametry, verze pro tisk, lomitko navic)
+ *
+ * SimHash: z viditelneho textu (bez znacek) se vezmou trojice po sobe jdoucich slov, kazda trojice hlasuje
+ * svym 64bitovym hashem o bitech otisku. Stranky se lisi jen malo, pokud se otisky lisi nejvyse
+ * v NearDuplicateBits bitech. Pro hledani se otisk deli na NearDuplicateBits + 1 pasem - dva otisky
+ * s nejvyse NearDuplicateBits rozdilnymi bity maji aspon jedno pasmo shodne.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <optional>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#include "page_analysis.h"
+
+// presny otisk HTML (FNV-1a); 0 pro prazdnou stranku
+uint64_t contentHash(std::string_view html);
+
+// SimHash viditelneho textu; 0, pokud ma stranka mene nez MinSimHashShingles trojic slov
+uint64_t simHash(std::string_view html);
+
+class CDuplicateIndex {
+	public:
+		// kolik bitu se mohou otisky tematu lisit
+		static constexpr int NearDuplicateBits = 3;
+		// kratsi texty nemaji vypovidajici SimHash (napr. stranky jen s odkazy) - par zmenenych slov
+		// pohne vice bity nez NearDuplicateBits a ruzne kratke stranky se naopak nahodne shoduji
+		static constexpr size_t MinSimHashShingles = 32;
+
+		struct Stats {
+			size_t exactDuplicates = 0;
+			size_t nearDuplicates = 0;
+			// odkazy z duplicit, ktere se neprochazeji
+			size_t skippedLinks = 0;
+			// z nich URL, ktere jeste nebyly navstivene - usetrena stazeni a analyzy
+			// (horni odhad, URL muze pozdeji najit i jina stranka)
+			size_t avoidedFetches = 0;
+		};
+
+	private:
+		static constexpr int Bands = NearDuplicateBits + 1;
+		static constexpr int BandBits = 64 / Bands;
+
+		mutable std::mutex m_mutex;
+		std::vector<std::string> m_urls;
+		std::unordered_map<uint64_t, uint32_t> m_exact;
+		// pasmo otisku -> stranky (indexy do m_urls) s timto pasmem
+		std::unordered_multimap<uint64_t, uint32_t> m_bands[Bands];
+		std::vector<uint64_t> m_simHashes;
+		Stats m_stats;
+
+	public:
+		// zaradi stranku do indexu, nebo vrati URL stranky, jejiz je duplicitou (stranka se pak nezaradi).
+		// Lze volat z vice vlaken
+		std::optional<std::string> Find_Or_Add(const PageAnalysisResult& page);
+
+		// zapocita preskocene odkazy duplicitni stranky; isNew - odkaz by se jinak zaradil k obchazeni
+		void Skip_Links(const PageAnalysisResult& page, const std::function<bool(const std::string&)>& isNew);
+
+		Stats Get_Stats() const;
+};
+
+// duplicitu nahradi zaznamem aliasu - URL, puvodni stranka a otisky, bez nadpisu a odkazu
+void makeAlias(PageAnalysisResult& page, std::string canonicalUrl);
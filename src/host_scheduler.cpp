@@ -0,0 +1,276 @@
+/**
+ * Rizeni zateze hostitelu - token bucket, Crawl-delay z robots.txt a AIMD okno soubeznych pozadavku
+ */
+
+#include "host_scheduler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+	std::string_view trim(std::string_view text) {
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+			text.remove_prefix(1);
+		}
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+			text.remove_suffix(1);
+		}
+		return text;
+	}
+
+	bool equalsCi(std::string_view a, std::string_view b) {
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+			return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+		});
+	}
+
+	// server odmita pozadavky kvuli zatezi
+	bool isThrottle(int status) {
+		return status == 429 || status == 503;
+	}
+
+	double toMs(CHostScheduler::Clock::duration duration) {
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+}
+
+double parseCrawlDelay(std::string_view robots) {
+	double crawlDelay = 0;
+	// skupina = po sobe jdouci radky User-agent a za nimi pravidla
+	bool inAgents = false;
+	bool matches = false;
+
+	while (!robots.empty()) {
+		size_t end = robots.find('\n');
+		std::string_view line = robots.substr(0, end);
+		robots.remove_prefix(end == std::string_view::npos ? robots.size() : end + 1);
+
+		line = line.substr(0, line.find('#'));
+		size_t colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			continue;
+		}
+		std::string_view field = trim(line.substr(0, colon));
+		std::string_view value = trim(line.substr(colon + 1));
+
+		if (equalsCi(field, "user-agent")) {
+			if (!inAgents) {
+				matches = false;
+				inAgents = true;
+			}
+			matches = matches || value == "*";
+			continue;
+		}
+		inAgents = false;
+
+		if (matches && equalsCi(field, "crawl-delay")) {
+			std::string number(value);
+			char* parsedEnd = nullptr;
+			double delay = std::strtod(number.c_str(), &parsedEnd);
+			if (parsedEnd != number.c_str() && delay > 0) {
+				crawlDelay = delay;
+			}
+		}
+	}
+	return crawlDelay;
+}
+
+CHostScheduler::CHostScheduler(double share)
+	: m_share{ std::clamp(share, 0.01, 1.0) } {
+}
+
+CHostScheduler& CHostScheduler::Instance() {
+	static CHostScheduler scheduler;
+	return scheduler;
+}
+
+void CHostScheduler::Set_Robots_Loader(RobotsLoader loader) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_robotsLoader = std::move(loader);
+}
+
+CHostScheduler::Host& CHostScheduler::Get_Host(const std::string& origin) {
+	auto it = m_hosts.find(origin);
+	if (it != m_hosts.end()) {
+		return it->second;
+	}
+
+	Host& host = m_hosts[origin];
+	host.maxWindow = std::max(1.0, MaxConcurrency * m_share);
+	host.window = std::clamp(InitialConcurrency * m_share, 1.0, host.maxWindow);
+	host.rate = MaxRequestsPerSecond * m_share;
+	host.burst = std::max(1.0, BurstRequests * m_share);
+	host.tokens = host.burst;
+	host.stats.concurrency = host.window;
+	return host;
+}
+
+void CHostScheduler::Set_Crawl_Delay(Host& host, double crawlDelay) {
+	crawlDelay = std::min(crawlDelay, MaxCrawlDelay);
+	host.stats.crawlDelay = crawlDelay;
+	if (crawlDelay <= 0) {
+		return;
+	}
+	// jeden pozadavek za crawlDelay pro vsechny instance dohromady
+	host.rate = std::min(host.rate, m_share / crawlDelay);
+	host.burst = 1;
+	host.tokens = std::min(host.tokens, host.burst);
+	host.maxWindow = 1;
+	host.window = 1;
+	host.stats.concurrency = host.window;
+}
+
+void CHostScheduler::Prepare(const std::string& origin) {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Host& host = Get_Host(origin);
+	if (!m_robotsLoader) {
+		return;
+	}
+	if (host.robots == RobotsState::Loading) {
+		m_released.wait(lock, [&host] { return host.robots == RobotsState::Loaded; });
+		return;
+	}
+	if (host.robots == RobotsState::Loaded) {
+		return;
+	}
+
+	host.robots = RobotsState::Loading;
+	RobotsLoader loader = m_robotsLoader;
+	lock.unlock();
+	std::string robots = loader(origin);
+	lock.lock();
+
+	// reference do unordered_map zustava platna i po vlozeni dalsich hostitelu
+	Set_Crawl_Delay(host, parseCrawlDelay(robots));
+	host.robots = RobotsState::Loaded;
+	m_released.notify_all();
+}
+
+void CHostScheduler::Refill(Host& host, Clock::time_point now) {
+	double elapsed = std::chrono::duration<double>(now - host.refilled).count();
+	host.tokens = std::min(host.burst, host.tokens + elapsed * host.rate);
+	host.refilled = now;
+}
+
+bool CHostScheduler::Try_Acquire_Locked(Host& host, Clock::duration& wait) {
+	Clock::time_point now = Clock::now();
+	if (now < host.notBefore) {
+		wait = host.notBefore - now;
+		return false;
+	}
+	if (host.inFlight >= static_cast<size_t>(host.window)) {
+		wait = Clock::duration::max();
+		return false;
+	}
+	Refill(host, now);
+	if (host.tokens < 1) {
+		wait = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((1 - host.tokens) / host.rate));
+		return false;
+	}
+
+	host.tokens -= 1;
+	host.inFlight++;
+	host.stats.requests++;
+	return true;
+}
+
+void CHostScheduler::Acquire(const std::string& origin) {
+	Prepare(origin);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	Host& host = Get_Host(origin);
+	Clock::time_point start = Clock::now();
+	Clock::duration wait;
+	while (!Try_Acquire_Locked(host, wait)) {
+		if (wait == Clock::duration::max()) {
+			m_released.wait(lock);
+		} else {
+			m_released.wait_for(lock, wait);
+		}
+	}
+	host.stats.waited += Clock::now() - start;
+}
+
+bool CHostScheduler::Try_Acquire(const std::string& origin, Clock::duration& wait) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return Try_Acquire_Locked(Get_Host(origin), wait);
+}
+
+void CHostScheduler::Decrease(Host& host, double factor, Clock::time_point now) {
+	// jedno zmenseni za dobu odezvy - odpovedi na pozadavky z puvodniho okna by ho jinak zmensily nekolikrat
+	if (now - host.lastDecrease < std::chrono::duration<double, std::milli>(host.latency)) {
+		return;
+	}
+	host.window = std::max(1.0, host.window * factor);
+	host.lastDecrease = now;
+}
+
+void CHostScheduler::Release(const std::string& origin, const Outcome& outcome) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Host& host = Get_Host(origin);
+	Clock::time_point now = Clock::now();
+	// okno roste, jen kdyz ho pozadavky skutecne zaplnuji - jinak by bez omezeni narostlo az do MaxConcurrency
+	bool windowFull = host.inFlight >= static_cast<size_t>(host.window);
+	if (host.inFlight > 0) {
+		host.inFlight--;
+	}
+
+	double latency = toMs(outcome.latency);
+	host.latency = host.latency == 0 ? latency : 0.8 * host.latency + 0.2 * latency;
+
+	if (isThrottle(outcome.status) || outcome.throttled > 0) {
+		host.stats.throttled += outcome.throttled + (isThrottle(outcome.status) ? 1 : 0);
+		host.throttleWindow = host.window;
+		Decrease(host, ErrorDecrease, now);
+		if (isThrottle(outcome.status)) {
+			std::chrono::seconds backoff = outcome.retryAfter;
+			if (backoff.count() <= 0) {
+				backoff = DefaultBackoff * (1ll << std::min<size_t>(host.consecutiveThrottles, 6));
+			}
+			host.notBefore = now + std::min(backoff, MaxBackoff);
+			host.consecutiveThrottles++;
+		}
+	} else if (outcome.status == 0 || outcome.status >= 500) {
+		host.stats.errors++;
+		Decrease(host, ErrorDecrease, now);
+	} else {
+		host.consecutiveThrottles = 0;
+		// latence jen z uspesnych odpovedi - chyby byvaji rychle a snizily by zaklad
+		host.baseLatency = host.baseLatency == 0 ? latency : std::min(host.baseLatency, latency);
+		if (host.latency > LatencyTolerance * std::max(host.baseLatency, 1.0)) {
+			Decrease(host, LatencyDecrease, now);
+		} else if (windowFull) {
+			bool nearLimit = host.throttleWindow > 0 && host.window + 1 >= host.throttleWindow;
+			host.window = std::min(host.maxWindow, host.window + 1 / (host.window * (nearLimit ? SlowIncreaseFactor : 1.0)));
+		}
+	}
+	host.stats.concurrency = host.window;
+	m_released.notify_all();
+}
+
+void CHostScheduler::Cancel(const std::string& origin) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Host& host = Get_Host(origin);
+	if (host.inFlight > 0) {
+		host.inFlight--;
+	}
+	host.tokens = std::min(host.burst, host.tokens + 1);
+	host.stats.requests--;
+	m_released.notify_all();
+}
+
+CHostScheduler::Stats CHostScheduler::Get_Stats(const std::string& origin) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_hosts.find(origin);
+	return it == m_hosts.end() ? Stats{} : it->second.stats;
+}
+
+void CHostScheduler::Print_Stats(std::ostream& os) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const auto& [origin, host] : m_hosts) {
+		os << "Hostitel " << origin << ": požadavků " << host.stats.requests << ", odmítnuto (429/503) " << host.stats.throttled
+		   << ", chyb " << host.stats.errors << ", souběžnost " << host.stats.concurrency
+		   << ", crawl-delay " << host.stats.crawlDelay << " s, čekání " << static_cast<long long>(toMs(host.stats.waited)) << " ms" << std::endl;
+	}
+}
@@ -0,0 +1,151 @@
+/**
+ * Rizeni zateze hostitelu - kolik pozadavku a jak rychle smi crawler na jeden hostitel poslat
+ *
+ * Pro kazdy hostitel (schema + host, getOrigin):
+ *   - token bucket omezuje rychlost pozadavku (MaxRequestsPerSecond, davka BurstRequests),
+ *     Crawl-delay z robots.txt ji snizi na jeden pozadavek za Crawl-delay sekund,
+ *   - okno soubeznych pozadavku se ridi AIMD: po uspesne odpovedi s beznou latenci roste o 1/okno
+ *     (zhruba o 1 za kazde okno odpovedi), pri 429/503, chybe serveru nebo latenci nad LatencyTolerance
+ *     nasobkem nejnizsi latence se nasobne zmensi (nejvyse jednou za dobu odezvy); blizko okna, pri kterem
+ *     hostitel naposledy odmitl, roste SlowIncreaseFactor krat pomaleji - kazde zkouseni hranice stoji odmitnuty pozadavek,
+ *   - po 429/503 se na hostitel neposila nic do konce Retry-After (bez nej exponencialne od DefaultBackoff).
+ *
+ * Lokalni rezimy sdileji instanci procesu (Instance); Worker A ridi sve Worker B vlastni instanci,
+ * protoze kazdy Worker B je samostatny proces a o ostatnich nevi.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <ostream>
+#include <cstddef>
+
+// Crawl-delay ze skupiny "User-agent: *" v robots.txt v sekundach; 0, pokud neni uveden
+double parseCrawlDelay(std::string_view robots);
+
+class CHostScheduler {
+	public:
+		using Clock = std::chrono::steady_clock;
+		// stahne robots.txt hostitele (argument je schema + host); prazdny retezec = robots.txt neni
+		using RobotsLoader = std::function<std::string(const std::string& origin)>;
+
+		static constexpr double MaxRequestsPerSecond = 20.0;
+		static constexpr double BurstRequests = 4.0;
+		static constexpr double InitialConcurrency = 2.0;
+		static constexpr double MaxConcurrency = 16.0;
+		// latence nad timto nasobkem nejnizsi namerene latence = server je pretizeny
+		static constexpr double LatencyTolerance = 2.0;
+		static constexpr double LatencyDecrease = 0.75;
+		static constexpr double ErrorDecrease = 0.5;
+		// nad oknem, pri kterem hostitel naposledy odmitl pozadavek, roste okno tolikrat pomaleji
+		static constexpr double SlowIncreaseFactor = 8.0;
+		static constexpr std::chrono::seconds DefaultBackoff{ 1 };
+		static constexpr std::chrono::seconds MaxBackoff{ 60 };
+		// vetsi Crawl-delay se orizne, jinak by jeden robots.txt zastavil obchod
+		static constexpr double MaxCrawlDelay = 30.0;
+
+		// vysledek jednoho pozadavku
+		struct Outcome {
+			// HTTP status (posledniho pokusu); 0 = chyba spojeni
+			int status = 0;
+			// odpovedi 429/503 pred poslednim pokusem (opakovani uvnitr Worker B)
+			size_t throttled = 0;
+			Clock::duration latency{};
+			// Retry-After odpovedi 429/503; 0 = server ho neposlal
+			std::chrono::seconds retryAfter{ 0 };
+		};
+
+		struct Stats {
+			size_t requests = 0;
+			size_t throttled = 0;     // odpovedi 429/503
+			size_t errors = 0;        // chyby spojeni a 5xx
+			double concurrency = 0;   // aktualni okno soubeznych pozadavku
+			double crawlDelay = 0;    // s, z robots.txt
+			Clock::duration waited{}; // celkova doba cekani v Acquire
+		};
+
+	private:
+		enum class RobotsState {
+			Unknown,
+			Loading,
+			Loaded
+		};
+
+		struct Host {
+			double window = InitialConcurrency;
+			double maxWindow = MaxConcurrency;
+			size_t inFlight = 0;
+
+			double rate = MaxRequestsPerSecond;
+			double burst = BurstRequests;
+			double tokens = BurstRequests;
+			Clock::time_point refilled = Clock::now();
+
+			// po 429/503 se ceka do tohoto casu
+			Clock::time_point notBefore{};
+			size_t consecutiveThrottles = 0;
+			Clock::time_point lastDecrease{};
+			// okno pri poslednim 429/503 - hranice, kterou hostitel snese; 0 = zatim neodmitl
+			double throttleWindow = 0;
+
+			// ms; klouzavy prumer a minimum
+			double latency = 0;
+			double baseLatency = 0;
+
+			RobotsState robots = RobotsState::Unknown;
+			Stats stats;
+		};
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_released;
+		std::unordered_map<std::string, Host> m_hosts;
+		RobotsLoader m_robotsLoader;
+		// podil teto instance na limitech hostitele (vice Worker A na jedne domene)
+		double m_share;
+
+		Host& Get_Host(const std::string& origin);
+		void Refill(Host& host, Clock::time_point now);
+		bool Try_Acquire_Locked(Host& host, Clock::duration& wait);
+		void Decrease(Host& host, double factor, Clock::time_point now);
+		void Set_Crawl_Delay(Host& host, double crawlDelay);
+
+	public:
+		// share - podil na limitech hostitele (rychlost, okno a Crawl-delay), 1 = cele limity
+		explicit CHostScheduler(double share = 1.0);
+
+		CHostScheduler(const CHostScheduler&) = delete;
+		CHostScheduler& operator=(const CHostScheduler&) = delete;
+
+		// instance procesu pro fetchPage
+		static CHostScheduler& Instance();
+
+		// bez loaderu se robots.txt nestahuje (napr. Worker B - Crawl-delay hlida jeho Worker A)
+		void Set_Robots_Loader(RobotsLoader loader);
+
+		// nacte robots.txt hostitele, pokud jeste nebyl nacten; ostatni vlakna na nacteni pockaji
+		void Prepare(const std::string& origin);
+
+		// pocka, az smi na hostitel poslat dalsi pozadavek, a zapocita ho; po dokonceni zavolat Release
+		void Acquire(const std::string& origin);
+
+		// neblokujici Acquire - pri neuspechu vrati ve wait, za jak dlouho to zkusit znovu
+		// (Clock::duration::max() = az skonci nektery bezici pozadavek)
+		bool Try_Acquire(const std::string& origin, Clock::duration& wait);
+
+		// dokonceny pozadavek - uvolni misto v okne a upravi limity hostitele
+		void Release(const std::string& origin, const Outcome& outcome);
+
+		// ziskane misto se nepouzilo (pozadavek se neposlal)
+		void Cancel(const std::string& origin);
+
+		Stats Get_Stats(const std::string& origin) const;
+
+		// radek souhrnu pro kazdy hostitel
+		void Print_Stats(std::ostream& os) const;
+};
@@ -0,0 +1,410 @@
+/**
+ * Однопрохідний сканер HTML тегів для аналізу сторінки
+ */
+
+#include "html_scanner.h"
+
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define HTML_SCANNER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC dovoluje pouzit AVX2 intrinsiky bez prepinacu, GCC/Clang potrebuji atribut funkce
+#if defined(HTML_SCANNER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HTML_SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HTML_SCANNER_TARGET_AVX2
+#endif
+
+namespace {
+
+    constexpr size_t npos = std::string_view::npos;
+    // vysledek hledani v nedokoncenem dokumentu: rozhodnuti zavisi na datech, ktera jeste neprisla
+    constexpr size_t needMore = npos - 1;
+    // kolik bajtu za '<' staci k rozliseni hledanych tagu ("<base" + dalsi znak)
+    constexpr size_t MinTagLookahead = 6;
+
+    // Вказівник на ядро пошуку: повертає перший збіг з c у [p, end) або end
+    using FindByteFn = const char* (*)(const char* p, const char* end, char c);
+
+    const char* findByteScalar(const char* p, const char* end, char c) {
+        while (p < end && *p != c) {
+            p++;
+        }
+        return p;
+    }
+
+#ifdef HTML_SCANNER_X86
+    const char* findByteSse2(const char* p, const char* end, char c) {
+        const __m128i needle = _mm_set1_epi8(c);
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+            if (mask != 0) {
+                return p + std::countr_zero(mask);
+            }
+            p += 16;
+        }
+        return findByteScalar(p, end, c);
+    }
+
+    HTML_SCANNER_TARGET_AVX2
+    const char* findByteAvx2(const char* p, const char* end, char c) {
+        const __m256i needle = _mm256_set1_epi8(c);
+        while (end - p >= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+            if (mask != 0) {
+                return p + std::countr_zero(mask);
+            }
+            p += 32;
+        }
+        return findByteScalar(p, end, c);
+    }
+
+    bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        // OSXSAVE + AVX a operacni system uklada registry YMM
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+#endif
+
+    ScanKernel resolveKernel(ScanKernel kernel) {
+        if (kernel == ScanKernel::Auto) {
+            static const ScanKernel best = isScanKernelSupported(ScanKernel::AVX2) ? ScanKernel::AVX2
+                : isScanKernelSupported(ScanKernel::SSE2) ? ScanKernel::SSE2
+                : ScanKernel::Scalar;
+            return best;
+        }
+        return isScanKernelSupported(kernel) ? kernel : ScanKernel::Scalar;
+    }
+
+    FindByteFn kernelFunction(ScanKernel kernel) {
+        switch (resolveKernel(kernel)) {
+#ifdef HTML_SCANNER_X86
+            case ScanKernel::AVX2: return findByteAvx2;
+            case ScanKernel::SSE2: return findByteSse2;
+#endif
+            default: return findByteScalar;
+        }
+    }
+
+    char toLowerAscii(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+
+    // prefix musi byt zadany malymi pismeny
+    bool startsWithAtCi(std::string_view html, size_t pos, std::string_view prefix) {
+        if (html.size() - pos < prefix.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < prefix.size(); i++) {
+            if (toLowerAscii(html[pos + i]) != prefix[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isTagNameChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-';
+    }
+
+    bool isQuote(char c) {
+        return c == '"' || c == '\'';
+    }
+
+    // Сканер одного буфера з вибраним ядром пошуку.
+    // Не final буфер - це початок документа, який ще завантажується: пошук, який нічого не знайшов
+    // до кінця буфера, ще нічого не вирішує (needMore)
+    class TagScanner {
+        private:
+            std::string_view m_html;
+            FindByteFn m_find;
+            bool m_final;
+
+            // npos з пошуку до кінця буфера
+            size_t notFound() const {
+                return m_final ? npos : needMore;
+            }
+
+        public:
+            TagScanner(std::string_view html, FindByteFn find, bool final = true) : m_html{ html }, m_find{ find }, m_final{ final } {}
+
+            // позиція першого c на [from, to) або npos
+            size_t find(char c, size_t from, size_t to = npos) const {
+                if (to > m_html.size()) {
+                    to = m_html.size();
+                }
+                if (from >= to) {
+                    return npos;
+                }
+                const char* hit = m_find(m_html.data() + from, m_html.data() + to, c);
+                return hit == m_html.data() + to ? npos : static_cast<size_t>(hit - m_html.data());
+            }
+
+            // Видаляє з тексту заголовка всі підрядки виду <[^>]*>
+            std::string stripTags(size_t begin, size_t end) const {
+                std::string clean;
+                clean.reserve(end - begin);
+
+                size_t pos = begin;
+                while (pos < end) {
+                    size_t lt = find('<', pos, end);
+                    if (lt == npos) {
+                        break;
+                    }
+                    size_t gt = find('>', lt + 1, end);
+                    if (gt == npos) {
+                        break;
+                    }
+                    clean.append(m_html, pos, lt - pos);
+                    pos = gt + 1;
+                }
+                clean.append(m_html, pos, end - pos);
+
+                return clean;
+            }
+
+            // Шукає атрибут href у тезі <a, що починається на позиції tagStart.
+            // Регулярний вираз має жадібне [^>]* перед href=, тому перевіряємо кандидатів від останнього до першого
+            // в межах до першого '>' за тегом. Повертає позицію '>', якою закінчується збіг, npos, або needMore.
+            size_t matchLink(size_t tagStart, size_t tagEnd, std::string_view& href) const {
+                // "href=" nemuze obsahovat '>', takze cely kandidat lezi pred tagEnd
+                for (size_t h = tagEnd; h-- > tagStart + 2;) {
+                    if (h + 5 > tagEnd || !startsWithAtCi(m_html, h, "href=")) {
+                        continue;
+                    }
+
+                    size_t valueStart = h + 6;
+                    if (valueStart > m_html.size() || !isQuote(m_html[h + 5])) {
+                        continue;
+                    }
+
+                    // pozdejsi kandidat ma prednost - bez dat pro nej nelze rozhodnout ani o drivejsich
+                    size_t valueEnd = m_html.find_first_of("\"'", valueStart);
+                    if (valueEnd == npos && !m_final) {
+                        return needMore;
+                    }
+                    if (valueEnd == npos || valueEnd == valueStart) {
+                        continue;
+                    }
+
+                    size_t gt = find('>', valueEnd + 1);
+                    if (gt == npos && !m_final) {
+                        return needMore;
+                    }
+                    if (gt == npos) {
+                        continue;
+                    }
+
+                    href = m_html.substr(valueStart, valueEnd - valueStart);
+                    return gt;
+                }
+
+                return npos;
+            }
+
+            // Шукає значення атрибуту href у тезі <base> (tagStart..tagEnd); повертає кінець значення, npos, якщо його немає,
+            // або needMore
+            size_t matchBaseHref(size_t tagStart, size_t tagEnd, std::string_view& href) const {
+                for (size_t h = tagStart + 5; h + 6 <= tagEnd; h++) {
+                    if (!startsWithAtCi(m_html, h, "href=") || !isQuote(m_html[h + 5])) {
+                        continue;
+                    }
+                    size_t valueStart = h + 6;
+                    size_t valueEnd = m_html.find(m_html[h + 5], valueStart);
+                    if (valueEnd == npos) {
+                        return notFound();
+                    }
+                    href = m_html.substr(valueStart, valueEnd - valueStart);
+                    return valueEnd;
+                }
+                return npos;
+            }
+
+            // Шукає закриваючий </hN> на тому ж рядку (. у ECMAScript не збігається з \r або \n).
+            // Повертає позицію закриваючого тегу, npos, або needMore (рядок ще не скінчився).
+            size_t matchHeaderClose(size_t textStart, char level) const {
+                size_t lineEnd = m_html.find_first_of("\r\n", textStart);
+
+                const char closing[] = { '<', '/', 'h', level, '>' };
+                for (size_t lt = find('<', textStart, lineEnd); lt != npos; lt = find('<', lt + 1, lineEnd)) {
+                    if (lt + sizeof(closing) <= lineEnd && startsWithAtCi(m_html, lt, std::string_view(closing, sizeof(closing)))) {
+                        return lt;
+                    }
+                }
+                return lineEnd == npos ? notFound() : npos;
+            }
+
+            // Сканує теги від state.pos. Повертає false, якщо для рішення про тег на state.pos бракує даних
+            // (лише не final буфер) - тоді state.pos вказує на цей тег.
+            bool scan(HtmlScanResult& result, HtmlScanState& state) const {
+                // Кожен шаблон має власну позицію, з якої може початися його наступний збіг (state.imgFrom ...) -
+                // так зберігається поведінка окремих (неперекривних) проходів регулярних виразів.
+                // plati jen prvni <base> s atributem href (state.haveBase)
+                for (size_t pos = find('<', state.pos); pos != npos; pos = find('<', pos + 1)) {
+                    state.pos = pos;
+                    if (!m_final && m_html.size() - pos < MinTagLookahead) {
+                        return false;
+                    }
+                    if (pos + 1 >= m_html.size()) {
+                        break;
+                    }
+                    // vsechny hledane tagy se rozlisuji uz podle prvniho pismene
+                    char first = toLowerAscii(m_html[pos + 1]);
+
+                    if (first == 'i' && pos >= state.imgFrom && startsWithAtCi(m_html, pos, "<img")) {
+                        size_t gt = find('>', pos + 4);
+                        if (gt != npos) {
+                            result.imageCount++;
+                            state.imgFrom = gt + 1;
+                        } else if (!m_final) {
+                            return false;
+                        } else {
+                            state.imgFrom = npos;
+                        }
+                    }
+                    else if (first == 'f' && pos >= state.formFrom && startsWithAtCi(m_html, pos, "<form")) {
+                        size_t gt = find('>', pos + 5);
+                        if (gt != npos) {
+                            result.formCount++;
+                            state.formFrom = gt + 1;
+                        } else if (!m_final) {
+                            return false;
+                        } else {
+                            state.formFrom = npos;
+                        }
+                    }
+                    else if (first == 'a' && pos >= state.linkFrom) {
+                        size_t tagEnd = find('>', pos + 2);
+                        if (tagEnd == npos && !m_final) {
+                            return false;
+                        }
+                        if (tagEnd == npos) {
+                            // без '>' жодне наступне посилання вже не може збігтися
+                            state.linkFrom = npos;
+                        } else {
+                            std::string_view href;
+                            size_t gt = matchLink(pos, tagEnd, href);
+                            if (gt == needMore) {
+                                return false;
+                            }
+                            if (gt != npos) {
+                                result.linkCount++;
+                                result.hrefs.emplace_back(href);
+                                state.linkFrom = gt + 1;
+                            }
+                        }
+                    }
+                    else if (first == 'b' && !state.haveBase && startsWithAtCi(m_html, pos, "<base")
+                        && (pos + 5 == m_html.size() || !isTagNameChar(m_html[pos + 5]))) {
+                        size_t tagEnd = find('>', pos + 5);
+                        if (tagEnd == npos && !m_final) {
+                            return false;
+                        }
+                        std::string_view href;
+                        size_t valueEnd = tagEnd == npos ? npos : matchBaseHref(pos, tagEnd, href);
+                        if (valueEnd == needMore) {
+                            return false;
+                        }
+                        if (valueEnd != npos) {
+                            result.baseHref = href;
+                            state.haveBase = true;
+                        }
+                    }
+                    else if (first == 'h' && pos >= state.headerFrom && m_html.size() - pos > 2 && m_html[pos + 2] >= '1' && m_html[pos + 2] <= '6') {
+                        char level = m_html[pos + 2];
+                        size_t openEnd = find('>', pos + 3);
+                        if (openEnd == npos && !m_final) {
+                            return false;
+                        }
+                        if (openEnd == npos) {
+                            state.headerFrom = npos;
+                        } else {
+                            size_t close = matchHeaderClose(openEnd + 1, level);
+                            if (close == needMore) {
+                                return false;
+                            }
+                            if (close != npos) {
+                                result.headers.push_back({ level - '0', stripTags(openEnd + 1, close) });
+                                state.headerFrom = close + 5;
+                            }
+                        }
+                    }
+                }
+                state.pos = m_html.size();
+                return true;
+            }
+    };
+}
+
+bool isScanKernelSupported(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::Auto:
+        case ScanKernel::Scalar:
+            return true;
+#ifdef HTML_SCANNER_X86
+        case ScanKernel::SSE2:
+            return true;
+        case ScanKernel::AVX2: {
+            static const bool hasAvx2 = cpuHasAvx2();
+            return hasAvx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* scanKernelName(ScanKernel kernel) {
+    switch (resolveKernel(kernel)) {
+        case ScanKernel::AVX2: return "AVX2";
+        case ScanKernel::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+void scanHtml(std::string_view html, HtmlScanResult& result, ScanKernel kernel) {
+    HtmlScanState state;
+    TagScanner(html, kernelFunction(kernel)).scan(result, state);
+}
+
+void CHtmlStreamScanner::Scan(bool final) {
+    if (TagScanner(m_document, kernelFunction(m_kernel), final).scan(m_result, m_state)) {
+        m_retryAt = 0;
+    } else {
+        m_retryAt = m_document.size() + (m_document.size() - m_state.pos);
+    }
+}
+
+void CHtmlStreamScanner::Append(std::string_view chunk) {
+    m_document.append(chunk);
+    if (m_document.size() >= m_retryAt) {
+        Scan(false);
+    }
+}
+
+void CHtmlStreamScanner::Finish() {
+    Scan(true);
+}
@@ -0,0 +1,83 @@
+/**
+ * Однопрохідний сканер HTML тегів для аналізу сторінки
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+
+// Результат сканування HTML - сирі дані, ще без нормалізації URL
+struct HtmlScanResult {
+    int imageCount = 0;
+    int linkCount = 0;
+    int formCount = 0;
+    std::vector<std::string> hrefs;                  // значення href з тегів <a>, у порядку появи
+    std::vector<std::pair<int, std::string>> headers; // рівень, текст без вкладених тегів
+    std::string baseHref;                            // href першого тегу <base> (порожній, якщо немає)
+};
+
+// Ядро пошуку символів '<' і '>' у буфері
+enum class ScanKernel {
+    Auto,   // найкраще ядро, яке підтримує процесор (визначається під час виконання)
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Чи можна використати дане ядро на поточному процесорі
+bool isScanKernelSupported(ScanKernel kernel);
+
+// Назва ядра для логу і бенчмарку; для Auto повертає назву реально вибраного ядра
+const char* scanKernelName(ScanKernel kernel);
+
+// Проходить буфер один раз, перескакуючи між символами '<', і заповнює result.
+// Назви тегів і атрибут href порівнюються без урахування регістру (<IMG>, <A HREF=...>, </H1>),
+// інакше результат збігається з попередніми регулярними виразами:
+//   <img[^>]*>
+//   <a[^>]*href=["']([^"']+)["'][^>]*>
+//   <form[^>]*>
+//   <h([1-6])[^>]*>(.*?)</h\1>   (текст очищений від <[^>]*>)
+// Додатково запам'ятовує href першого тегу <base>, відносно якого розв'язуються відносні посилання.
+// Непідтримуване ядро замінюється скалярним.
+void scanHtml(std::string_view html, HtmlScanResult& result, ScanKernel kernel = ScanKernel::Auto);
+
+// Стан scanHtml між кусками документа (CHtmlStreamScanner)
+struct HtmlScanState {
+    size_t pos = 0;        // звідки шукати наступний '<'
+    size_t imgFrom = 0;
+    size_t linkFrom = 0;
+    size_t formFrom = 0;
+    size_t headerFrom = 0;
+    bool haveBase = false;
+};
+
+// Сканер документа, який ще завантажується: Append сканує теги, про які вже можна вирішити
+// (тег, якому для рішення бракує даних - '>', лапки, кінець рядка заголовка - чекає на наступні куски),
+// Finish доскановує залишок. Результат збігається з scanHtml на цілому документі.
+class CHtmlStreamScanner {
+    private:
+        ScanKernel m_kernel;
+        std::string m_document;
+        HtmlScanResult m_result;
+        HtmlScanState m_state;
+        // незавершений тег пробуємо знову, аж коли документ доросте сюди - інакше довгий рядок
+        // з незакритим <hN> сканувався б заново з кожним куском
+        size_t m_retryAt{ 0 };
+
+        void Scan(bool final);
+
+    public:
+        explicit CHtmlStreamScanner(ScanKernel kernel = ScanKernel::Auto) : m_kernel{ kernel } {}
+
+        void Append(std::string_view chunk);
+        void Finish();
+
+        // весь отриманий документ (після Finish його можна забрати)
+        const std::string& Document() const { return m_document; }
+        std::string Take_Document() { return std::move(m_document); }
+
+        HtmlScanResult& Result() { return m_result; }
+};
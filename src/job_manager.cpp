@@ -0,0 +1,174 @@
+/**
+ * Ulohy obchodu (joby) zadane pres server - fronta s omezenou kapacitou a pevny pocet vlaken, ktera je zpracovavaji
+ */
+
+#include "job_manager.h"
+
+#include <exception>
+
+const char* jobStateName(JobState state) {
+	switch (state) {
+		case JobState::Queued:
+			return "queued";
+		case JobState::Running:
+			return "running";
+		case JobState::Done:
+			return "done";
+		default:
+			return "failed";
+	}
+}
+
+CJobManager::CJobManager(Runner runner, size_t workers, size_t queueCapacity, size_t maxFinishedJobs)
+	: m_runner{ std::move(runner) }, m_queueCapacity{ queueCapacity }, m_maxFinishedJobs{ maxFinishedJobs } {
+	if (workers == 0) {
+		workers = 1;
+	}
+	for (size_t i = 0; i < workers; i++) {
+		m_workers.emplace_back(&CJobManager::Worker_Loop, this);
+	}
+}
+
+CJobManager::~CJobManager() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_queueChanged.notify_all();
+
+	// bezici joby dobehnou, cekajici se zahodi
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+std::optional<uint64_t> CJobManager::Submit(std::vector<std::string> urls) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_stopping || m_queue.size() >= m_queueCapacity) {
+		return std::nullopt;
+	}
+
+	auto job = std::make_shared<Job>();
+	job->id = m_nextId++;
+	job->urls = std::move(urls);
+	job->progress.domainsTotal = job->urls.size();
+
+	m_jobs[job->id] = job;
+	m_queue.push_back(job);
+	m_queueChanged.notify_one();
+	return job->id;
+}
+
+void CJobManager::Worker_Loop() {
+	while (true) {
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_queueChanged.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+			if (m_stopping) {
+				return;
+			}
+
+			job = m_queue.front();
+			m_queue.pop_front();
+			job->state = JobState::Running;
+			job->started = std::chrono::steady_clock::now();
+		}
+
+		Run_Job(*job);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_finishedOrder.push_back(job->id);
+			while (m_finishedOrder.size() > m_maxFinishedJobs) {
+				m_jobs.erase(m_finishedOrder.front());
+				m_finishedOrder.pop_front();
+			}
+		}
+		m_jobFinished.notify_all();
+	}
+}
+
+void CJobManager::Run_Job(Job& job) {
+	CCrawlProgress& progress = CCrawlProgress::Instance();
+	progress.Start(job.urls.size());
+
+	std::string output;
+	std::string error;
+	// vyjimka z vlakna by ukoncila cely proces - job se jen oznaci jako neuspesny
+	try {
+		if (m_runner) {
+			m_runner(job.urls, output);
+		}
+	}
+	catch (const std::exception& ex) {
+		error = "Doslo k vyjimce pri zpracovani pozadavku: " + std::string(ex.what());
+	}
+	catch (...) {
+		error = "Neznama vyjimka";
+	}
+
+	progress.Finish();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	job.progress = progress.Get();
+	job.output = std::move(output);
+	job.error = std::move(error);
+	job.state = job.error.empty() ? JobState::Done : JobState::Failed;
+	job.finished = std::chrono::steady_clock::now();
+}
+
+bool CJobManager::Get_Status(uint64_t id, JobStatus& status) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_jobs.find(id);
+	if (it == m_jobs.end()) {
+		return false;
+	}
+	const Job& job = *it->second;
+
+	status = JobStatus{};
+	status.id = job.id;
+	status.state = job.state;
+	status.urlCount = job.urls.size();
+	status.error = job.error;
+
+	auto now = std::chrono::steady_clock::now();
+	switch (job.state) {
+		case JobState::Queued:
+			status.progress = job.progress;
+			for (size_t i = 0; i < m_queue.size(); i++) {
+				if (m_queue[i]->id == id) {
+					status.queuePosition = i + 1;
+					break;
+				}
+			}
+			break;
+		case JobState::Running:
+			status.progress = CCrawlProgress::Instance().Get();
+			status.elapsedSeconds = std::chrono::duration<double>(now - job.started).count();
+			break;
+		default:
+			status.progress = job.progress;
+			status.elapsedSeconds = std::chrono::duration<double>(job.finished - job.started).count();
+			break;
+	}
+	return true;
+}
+
+bool CJobManager::Wait_Finished(uint64_t id, std::chrono::milliseconds timeout) const {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_jobFinished.wait_for(lock, timeout, [this, id]() {
+		auto it = m_jobs.find(id);
+		return it == m_jobs.end() || (it->second->state != JobState::Queued && it->second->state != JobState::Running);
+	});
+}
+
+bool CJobManager::Get_Output(uint64_t id, std::string& output) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_jobs.find(id);
+	if (it == m_jobs.end() || it->second->state != JobState::Done) {
+		return false;
+	}
+	output = it->second->output;
+	return true;
+}
@@ -0,0 +1,104 @@
+/**
+ * Ulohy obchodu (joby) zadane pres server - fronta s omezenou kapacitou a pevny pocet vlaken, ktera je zpracovavaji
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "crawl_progress.h"
+
+enum class JobState {
+	Queued,
+	Running,
+	Done,
+	Failed
+};
+
+// textovy nazev stavu pro API ("queued", "running", "done", "failed")
+const char* jobStateName(JobState state);
+
+// stav jobu v okamziku dotazu
+struct JobStatus {
+	uint64_t id = 0;
+	JobState state = JobState::Queued;
+	size_t urlCount = 0;
+	size_t queuePosition = 0;       // poradi ve fronte (1 = dalsi na rade), jen pro Queued
+	CCrawlProgress::Snapshot progress; // prubeh (Running) nebo konecne citace (Done, Failed)
+	double elapsedSeconds = 0;      // od spusteni, u cekajiciho jobu 0
+	std::string error;              // jen pro Failed
+};
+
+class CJobManager {
+	public:
+		// zpracovani jednoho jobu - stejny tvar jako callback formulare (URL, HTML vystup)
+		using Runner = std::function<void(const std::vector<std::string>&, std::string&)>;
+
+	private:
+		struct Job {
+			uint64_t id;
+			std::vector<std::string> urls;
+			JobState state{ JobState::Queued };
+			std::string output;
+			std::string error;
+			CCrawlProgress::Snapshot progress;
+			std::chrono::steady_clock::time_point started;
+			std::chrono::steady_clock::time_point finished;
+		};
+
+		Runner m_runner;
+		size_t m_queueCapacity;
+		size_t m_maxFinishedJobs;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_queueChanged;
+		mutable std::condition_variable m_jobFinished;
+
+		std::deque<std::shared_ptr<Job>> m_queue;
+		std::unordered_map<uint64_t, std::shared_ptr<Job>> m_jobs;
+		// dokoncene joby od nejstarsiho - nejstarsi se zahazuji nad m_maxFinishedJobs
+		std::deque<uint64_t> m_finishedOrder;
+
+		uint64_t m_nextId{ 1 };
+		bool m_stopping{ false };
+
+		std::vector<std::thread> m_workers;
+
+		void Worker_Loop();
+		void Run_Job(Job& job);
+
+	public:
+		// workers - pocet soubezne bezicich jobu; prubeh bezicich jobu se cte ze sdileneho CCrawlProgress,
+		//           smysluplne citace tedy dava jen jedno vlakno (MPI master navic neumi dva obchody najednou)
+		// queueCapacity - kolik jobu muze cekat; dalsi Submit se odmitne
+		// maxFinishedJobs - kolik dokoncenych jobu (vcetne vystupu) se drzi pro dotazy
+		CJobManager(Runner runner, size_t workers, size_t queueCapacity, size_t maxFinishedJobs);
+		~CJobManager();
+
+		CJobManager(const CJobManager&) = delete;
+		CJobManager& operator=(const CJobManager&) = delete;
+
+		// zaradi job do fronty; vraci jeho id, nebo nic, pokud je fronta plna
+		std::optional<uint64_t> Submit(std::vector<std::string> urls);
+
+		// vraci false pro nezname (nebo uz zahozene) id
+		bool Get_Status(uint64_t id, JobStatus& status) const;
+
+		// ceka nejvyse timeout na dokonceni jobu; vraci true, pokud uz nebezi ani neceka (i pro nezname id)
+		bool Wait_Finished(uint64_t id, std::chrono::milliseconds timeout) const;
+
+		// HTML vystup dokonceneho jobu; vraci false, pokud job neexistuje nebo neni ve stavu Done
+		bool Get_Output(uint64_t id, std::string& output) const;
+};
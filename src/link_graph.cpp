@@ -0,0 +1,274 @@
+/**
+ * Binarni graf odkazu ve formatu CSR (compressed sparse row) - graph.bin vedle map.txt
+ */
+
+#include "link_graph.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	constexpr char Magic[8] = { 'U', 'P', 'P', 'C', 'S', 'R', '1', '\0' };
+	// verze 2: poradi odkazu s opakovanim cile s prestavkou (orderOffsets, orderedNodes, order)
+	constexpr uint32_t Version = 2;
+	constexpr uint32_t ByteOrderMark = 0x01020304;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t byteOrder;
+		uint64_t nodeCount;
+		uint64_t edgeCount;
+		uint64_t urlBytes;
+		uint64_t orderedNodeCount;
+		uint64_t orderCount;
+	};
+	static_assert(sizeof(Header) == 56 && sizeof(Header) % 8 == 0, "sekce za hlavickou musi byt zarovnane");
+
+	template <typename T>
+	void writeArray(std::ofstream& out, const std::vector<T>& values) {
+		out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+	}
+}
+
+uint32_t CLinkGraphBuilder::Add_Node(std::string_view url) {
+	uint32_t index = static_cast<uint32_t>(Node_Count());
+	m_urls.append(url);
+	m_urlOffsets.push_back(m_urls.size());
+	return index;
+}
+
+void CLinkGraphBuilder::Close_Sources_Before(uint32_t source) {
+	if (m_edgeOffsets.size() > source) {
+		return;
+	}
+	// otevreny zdroj je m_edgeOffsets.size() - 1
+	if (m_sourceScattered) {
+		m_orderedNodes.push_back(static_cast<uint32_t>(m_edgeOffsets.size() - 1));
+		m_order.insert(m_order.end(), m_sourceLinks.begin(), m_sourceLinks.end());
+		m_orderOffsets.push_back(m_order.size());
+	}
+	m_sourceLinks.clear();
+	m_sourceScattered = false;
+
+	while (m_edgeOffsets.size() <= source) {
+		m_edgeOffsets.push_back(m_targets.size());
+	}
+}
+
+void CLinkGraphBuilder::Add_Edge(uint32_t source, uint32_t target) {
+	if (m_lastSource.size() < Node_Count()) {
+		m_lastSource.resize(Node_Count(), 0);
+		m_lastEdge.resize(Node_Count(), 0);
+	}
+	Close_Sources_Before(source);
+
+	// zdroj + 1, aby 0 znamenala "zatim zadna hrana"
+	if (m_lastSource[target] == source + 1) {
+		uint32_t edge = m_lastEdge[target] - static_cast<uint32_t>(m_edgeOffsets.back());
+		// opakovany cil po odkazu jinam - map.txt uz nejde zapsat jen z poradi hran
+		m_sourceScattered = m_sourceScattered || m_sourceLinks.back() != edge;
+		m_sourceLinks.push_back(edge);
+		m_multiplicity[m_lastEdge[target]]++;
+		return;
+	}
+	m_lastSource[target] = source + 1;
+	m_lastEdge[target] = static_cast<uint32_t>(m_targets.size());
+	m_sourceLinks.push_back(static_cast<uint32_t>(m_targets.size() - m_edgeOffsets.back()));
+	m_targets.push_back(target);
+	m_multiplicity.push_back(1);
+}
+
+bool CLinkGraphBuilder::Write(const std::string& path) {
+	Close_Sources_Before(static_cast<uint32_t>(Node_Count()));
+
+	Header header{};
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.byteOrder = ByteOrderMark;
+	header.nodeCount = Node_Count();
+	header.edgeCount = m_targets.size();
+	header.urlBytes = m_urls.size();
+	header.orderedNodeCount = m_orderedNodes.size();
+	header.orderCount = m_order.size();
+
+	std::ofstream out(path, std::ios::binary);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	writeArray(out, m_urlOffsets);
+	writeArray(out, m_edgeOffsets);
+	writeArray(out, m_orderOffsets);
+	writeArray(out, m_targets);
+	writeArray(out, m_multiplicity);
+	writeArray(out, m_orderedNodes);
+	writeArray(out, m_order);
+	out.write(m_urls.data(), static_cast<std::streamsize>(m_urls.size()));
+	return static_cast<bool>(out);
+}
+
+CLinkGraphView::~CLinkGraphView() {
+	Close();
+}
+
+void CLinkGraphView::Close() {
+	m_file.Close();
+	m_nodeCount = 0;
+	m_edgeCount = 0;
+	m_orderedNodeCount = 0;
+}
+
+bool CLinkGraphView::Open(const std::string& path, std::string& error, bool validate) {
+	Close();
+
+	if (!m_file.Open(path, error)) {
+		return false;
+	}
+	if (!Parse(validate, error)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool CLinkGraphView::Parse(bool validate, std::string& error) {
+	const char* data = m_file.Data();
+	size_t size = m_file.Size();
+	if (size < sizeof(Header)) {
+		error = "Soubor je prilis kratky";
+		return false;
+	}
+	Header header;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+		error = "Neznamy format nebo verze grafu";
+		return false;
+	}
+	if (header.byteOrder != ByteOrderMark) {
+		error = "Graf byl zapsan s jinym poradim bajtu";
+		return false;
+	}
+
+	// velikosti sekci v uint64, aby nepretekly ani u poskozene hlavicky
+	uint64_t remaining = size - sizeof(Header);
+	uint64_t maxCount = remaining / sizeof(uint32_t);
+	if (header.nodeCount >= maxCount || header.edgeCount > maxCount || header.urlBytes > remaining
+		|| header.orderedNodeCount >= maxCount || header.orderCount > maxCount) {
+		error = "Poskozena hlavicka grafu";
+		return false;
+	}
+	uint64_t offsetsBytes = (header.nodeCount + 1) * sizeof(uint64_t);
+	uint64_t orderOffsetsBytes = (header.orderedNodeCount + 1) * sizeof(uint64_t);
+	uint64_t expected = 2 * offsetsBytes + orderOffsetsBytes + 2 * header.edgeCount * sizeof(uint32_t)
+		+ (header.orderedNodeCount + header.orderCount) * sizeof(uint32_t) + header.urlBytes;
+	if (expected != remaining) {
+		error = "Velikost souboru neodpovida hlavicce grafu";
+		return false;
+	}
+
+	const char* pos = data + sizeof(Header);
+	m_urlOffsets = reinterpret_cast<const uint64_t*>(pos);
+	pos += offsetsBytes;
+	m_edgeOffsets = reinterpret_cast<const uint64_t*>(pos);
+	pos += offsetsBytes;
+	m_orderOffsets = reinterpret_cast<const uint64_t*>(pos);
+	pos += orderOffsetsBytes;
+	m_targets = reinterpret_cast<const uint32_t*>(pos);
+	pos += header.edgeCount * sizeof(uint32_t);
+	m_multiplicity = reinterpret_cast<const uint32_t*>(pos);
+	pos += header.edgeCount * sizeof(uint32_t);
+	m_orderedNodes = reinterpret_cast<const uint32_t*>(pos);
+	pos += header.orderedNodeCount * sizeof(uint32_t);
+	m_order = reinterpret_cast<const uint32_t*>(pos);
+	pos += header.orderCount * sizeof(uint32_t);
+	m_urls = pos;
+
+	m_nodeCount = header.nodeCount;
+	m_edgeCount = header.edgeCount;
+	m_orderedNodeCount = header.orderedNodeCount;
+
+	if (m_urlOffsets[0] != 0 || m_urlOffsets[m_nodeCount] != header.urlBytes
+		|| m_edgeOffsets[0] != 0 || m_edgeOffsets[m_nodeCount] != m_edgeCount
+		|| m_orderOffsets[0] != 0 || m_orderOffsets[m_orderedNodeCount] != header.orderCount) {
+		error = "Poskozene offsety grafu";
+		return false;
+	}
+
+	if (validate) {
+		for (uint64_t i = 0; i < m_nodeCount; i++) {
+			if (m_urlOffsets[i] > m_urlOffsets[i + 1] || m_edgeOffsets[i] > m_edgeOffsets[i + 1]) {
+				error = "Poskozene offsety grafu";
+				return false;
+			}
+		}
+		for (uint64_t i = 0; i < m_edgeCount; i++) {
+			if (m_targets[i] >= m_nodeCount) {
+				error = "Hrana vede mimo graf";
+				return false;
+			}
+		}
+		for (uint64_t j = 0; j < m_orderedNodeCount; j++) {
+			uint32_t node = m_orderedNodes[j];
+			if (node >= m_nodeCount || (j > 0 && node <= m_orderedNodes[j - 1]) || m_orderOffsets[j] > m_orderOffsets[j + 1]) {
+				error = "Poskozene poradi odkazu grafu";
+				return false;
+			}
+			uint64_t edges = m_edgeOffsets[node + 1] - m_edgeOffsets[node];
+			for (uint64_t k = m_orderOffsets[j]; k < m_orderOffsets[j + 1]; k++) {
+				if (m_order[k] >= edges) {
+					error = "Poskozene poradi odkazu grafu";
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+std::string_view CLinkGraphView::Url(uint32_t node) const {
+	return std::string_view(m_urls + m_urlOffsets[node], m_urlOffsets[node + 1] - m_urlOffsets[node]);
+}
+
+std::span<const uint32_t> CLinkGraphView::Targets(uint32_t node) const {
+	return std::span<const uint32_t>(m_targets + m_edgeOffsets[node], m_edgeOffsets[node + 1] - m_edgeOffsets[node]);
+}
+
+std::span<const uint32_t> CLinkGraphView::Multiplicities(uint32_t node) const {
+	return std::span<const uint32_t>(m_multiplicity + m_edgeOffsets[node], m_edgeOffsets[node + 1] - m_edgeOffsets[node]);
+}
+
+std::span<const uint32_t> CLinkGraphView::Link_Order(uint32_t node) const {
+	const uint32_t* end = m_orderedNodes + m_orderedNodeCount;
+	const uint32_t* it = std::lower_bound(m_orderedNodes, end, node);
+	if (it == end || *it != node) {
+		return {};
+	}
+	size_t j = static_cast<size_t>(it - m_orderedNodes);
+	return std::span<const uint32_t>(m_order + m_orderOffsets[j], m_orderOffsets[j + 1] - m_orderOffsets[j]);
+}
+
+void writeMapText(const CLinkGraphView& graph, std::ostream& os) {
+	uint32_t nodeCount = static_cast<uint32_t>(graph.Node_Count());
+
+	for (uint32_t node = 0; node < nodeCount; node++) {
+		os << graph.Url(node) << '\n';
+	}
+
+	for (uint32_t node = 0; node < nodeCount; node++) {
+		std::string_view source = graph.Url(node);
+		auto targets = graph.Targets(node);
+		auto order = graph.Link_Order(node);
+		if (!order.empty()) {
+			for (uint32_t edge : order) {
+				os << source << ' ' << graph.Url(targets[edge]) << '\n';
+			}
+			continue;
+		}
+		auto multiplicity = graph.Multiplicities(node);
+		for (size_t i = 0; i < targets.size(); i++) {
+			std::string_view target = graph.Url(targets[i]);
+			for (uint32_t k = 0; k < multiplicity[i]; k++) {
+				os << source << ' ' << target << '\n';
+			}
+		}
+	}
+}
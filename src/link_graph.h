@@ -0,0 +1,113 @@
+/**
+ * Binarni graf odkazu ve formatu CSR (compressed sparse row) - graph.bin vedle map.txt
+ *
+ * Format (little-endian, vsechny sekce zarovnane na 8 bajtu, soubor lze primo namapovat do pameti):
+ *   hlavicka: magic "UPPCSR1\0", verze (uint32), znacka poradi bajtu 0x01020304 (uint32),
+ *             pocet uzlu N (uint64), pocet ruznych hran E (uint64), velikost textu URL (uint64),
+ *             pocet uzlu s vlastnim poradim odkazu M (uint64), delka poradi odkazu L (uint64)
+ *   uint64 urlOffsets[N + 1]   - zacatky URL v textu URL
+ *   uint64 edgeOffsets[N + 1]  - hrany uzlu i jsou targets[edgeOffsets[i] .. edgeOffsets[i + 1])
+ *   uint64 orderOffsets[M + 1] - poradi odkazu uzlu orderedNodes[j] je order[orderOffsets[j] .. orderOffsets[j + 1])
+ *   uint32 targets[E]          - indexy cilovych uzlu bez duplicit, v poradi prvniho vyskytu odkazu
+ *   uint32 multiplicity[E]     - kolikrat stranka na cil odkazuje
+ *   uint32 orderedNodes[M]     - vzestupne uzly, ktere na nektery cil odkazuji opakovane, ale ne hned za sebou
+ *   uint32 order[L]            - odkazy techto uzlu v puvodnim poradi jako indexy hran v ramci uzlu
+ *   char urls[]                - URL uzlu za sebou bez oddelovacu
+ * Uzly jsou obchazene stranky v poradi uzlu v map.txt, hrany vedou jen mezi nimi (stejne jako v map.txt).
+ * Odkazy ostatnich uzlu jdou v map.txt v poradi hran, kazda hrana tolikrat, kolik je jeji nasobnost.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+#include "mapped_file.h"
+
+class CLinkGraphBuilder {
+	private:
+		std::string m_urls;
+		std::vector<uint64_t> m_urlOffsets{ 0 };
+		std::vector<uint64_t> m_edgeOffsets{ 0 };
+		std::vector<uint32_t> m_targets;
+		std::vector<uint32_t> m_multiplicity;
+
+		// pro odstraneni duplicit: u ciloveho uzlu zdroj + 1, ze ktereho na nej vede posledni hrana, a jeji index
+		std::vector<uint32_t> m_lastSource;
+		std::vector<uint32_t> m_lastEdge;
+
+		// puvodni poradi odkazu uzlu, jejichz opakovane odkazy nejdou za sebou (viz format)
+		std::vector<uint64_t> m_orderOffsets{ 0 };
+		std::vector<uint32_t> m_orderedNodes;
+		std::vector<uint32_t> m_order;
+		// odkazy otevreneho zdroje jako indexy hran v ramci zdroje; ulozi se, jen pokud se cil opakoval s prestavkou
+		std::vector<uint32_t> m_sourceLinks;
+		bool m_sourceScattered{ false };
+
+		// uzavre seznamy hran vsech uzlu pred source
+		void Close_Sources_Before(uint32_t source);
+
+	public:
+		// prida uzel a vrati jeho index; vsechny uzly je nutne pridat pred prvni hranou
+		uint32_t Add_Node(std::string_view url);
+
+		// prida odkaz ze source na target; hrany musi prichazet serazene podle zdroje.
+		// Opakovany odkaz na stejny cil jen zvysi jeho nasobnost
+		void Add_Edge(uint32_t source, uint32_t target);
+
+		size_t Node_Count() const { return m_urlOffsets.size() - 1; }
+
+		// zapise graf do souboru; vraci false pri chybe zapisu
+		bool Write(const std::string& path);
+};
+
+// graf namapovany ze souboru - bez kopirovani a bez parsovani textu
+class CLinkGraphView {
+	private:
+		CMappedFile m_file;
+
+		uint64_t m_nodeCount{ 0 };
+		uint64_t m_edgeCount{ 0 };
+		const uint64_t* m_urlOffsets{ nullptr };
+		const uint64_t* m_edgeOffsets{ nullptr };
+		const uint32_t* m_targets{ nullptr };
+		const uint32_t* m_multiplicity{ nullptr };
+		uint64_t m_orderedNodeCount{ 0 };
+		const uint64_t* m_orderOffsets{ nullptr };
+		const uint32_t* m_orderedNodes{ nullptr };
+		const uint32_t* m_order{ nullptr };
+		const char* m_urls{ nullptr };
+
+		void Close();
+
+		// kontrola hlavicky a velikosti sekci; validate - navic projde offsety a cile hran
+		bool Parse(bool validate, std::string& error);
+
+	public:
+		CLinkGraphView() = default;
+		~CLinkGraphView();
+
+		CLinkGraphView(const CLinkGraphView&) = delete;
+		CLinkGraphView& operator=(const CLinkGraphView&) = delete;
+
+		// namapuje soubor; pri chybe vrati false a popis v error.
+		// validate = false preskoci linearni kontrolu offsetu a cilu (jen pro duveryhodne soubory)
+		bool Open(const std::string& path, std::string& error, bool validate = true);
+
+		uint64_t Node_Count() const { return m_nodeCount; }
+		uint64_t Edge_Count() const { return m_edgeCount; }
+
+		std::string_view Url(uint32_t node) const;
+		std::span<const uint32_t> Targets(uint32_t node) const;
+		std::span<const uint32_t> Multiplicities(uint32_t node) const;
+		// odkazy uzlu v puvodnim poradi jako indexy do Targets(node); prazdne, pokud jdou opakovane odkazy za sebou
+		std::span<const uint32_t> Link_Order(uint32_t node) const;
+};
+
+// zapise graf ve formatu map.txt: uzly, pak hrany "zdroj cil" v puvodnim poradi odkazu (bajtove shodne s map.txt)
+void writeMapText(const CLinkGraphView& graph, std::ostream& os);
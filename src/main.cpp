@@ -9,21 +9,115 @@
  #include <unordered_set>
  #include <unordered_map>
  #include <queue>
- #include <regex>
+ #include <deque>
+ #include <algorithm>
  #include <filesystem>
  #include <chrono>
  #include <sstream>
 #include <mpi.h>
  #include <iomanip>
+ #include <thread>
+ #include <atomic>
+ #include <mutex>
+ #include <functional>
+ #include <memory>
+ #include <cstdint>
+ #include <optional>
 
  #include "utils.h"
  #include "server.h"
+ #include "html_scanner.h"
+ #include "connection_pool.h"
+ #include "pipeline.h"
+ #include "work_stealing.h"
+ #include "crawl_frontier.h"
+ #include "url_resolver.h"
+ #include "page_analysis.h"
+ #include "page_message.h"
+ #include "mpi_protocol.h"
+ #include "worker_group.h"
+ #include "distributed_frontier.h"
+ #include "page_batch_sender.h"
+ #include "result_writer.h"
+ #include "crawl_progress.h"
+ #include "page_archive.h"
+ #include "recrawl_cache.h"
+ #include "duplicate_index.h"
+ #include "host_scheduler.h"
+ #include "dns_cache.h"
+ #include "result_store.h"
+ #include "page_analyzer.h"
 
 
 static const std::string MAP_FILE_NAME = "/map.txt";
 static const std::string CONTENT_FILE_NAME = "/content.txt";
 static const std::string LOG_FILE_NAME = "/log.txt";
-static const bool isParallel = false;
+// MPI verzi, rezim obchazeni bez MPI a rizeni zateze lze prepsat pri prekladu (varianty programu pro tools/load_test.sh):
+// -DUPP_PARALLEL=1, -DUPP_CRAWL_MODE=Serial|Pipelined|WorkStealing, -DUPP_POLITE_CRAWLING=0
+#ifndef UPP_PARALLEL
+#define UPP_PARALLEL 0
+#endif
+#ifndef UPP_CRAWL_MODE
+#define UPP_CRAWL_MODE Serial
+#endif
+#ifndef UPP_POLITE_CRAWLING
+#define UPP_POLITE_CRAWLING 1
+#endif
+static const bool isParallel = UPP_PARALLEL;
+// rezim verze bez MPI
+enum class CrawlMode {
+    Serial,       // serialCrawl - jedno vlakno
+    Pipelined,    // pipelinedCrawl - stahovaci vlakna soubezne s analyzou
+    WorkStealing  // workStealingCrawl - vlakna s vlastnimi frontami a kradenim prace
+};
+static const CrawlMode localCrawlMode = CrawlMode::UPP_CRAWL_MODE;
+// mnozina navstivenych URL v serialCrawl a workerA; otisky setri pamet u velkych domen za cenu zanedbatelne sance kolize
+static const VisitedSetMode visitedSetMode = VisitedSetMode::Exact;
+// pocet stahovacich vlaken a kapacita front mezi stupni pipeline
+static const size_t PipelineFetchers = 8;
+static const size_t PipelineQueueCapacity = 16;
+// kolik URL muze mit Worker A odeslanych kazdemu Worker B dopredu (1 = Worker B po kazde strance ceka na Worker A)
+static const int PrefetchDepth = 2;
+// maximalni delka URL v uloze pro Worker B - velikost bufferu, do ktereho Worker B predem prijima dalsi ulohu
+static const int MaxTaskUrlLength = 8192;
+// rezim MPI verze
+enum class MpiCrawlMode {
+    DomainPerWorkerA, // kazdy Worker A obchazi celou jednu domenu (limit 100 stranek)
+    SharedDomain      // vsechny Worker A obchazi spolecne jednu domenu, URL jsou rozdelene mezi ne podle hashe
+};
+static const MpiCrawlMode mpiCrawlMode = MpiCrawlMode::DomainPerWorkerA;
+// limit stranek na jednoho Worker A v rezimu SharedDomain - celkovy limit roste s poctem Worker A
+static const int SharedDomainMaxUrlsPerWorkerA = 1000;
+// po kolika URL se davka pro jineho Worker A odesle hned, bez cekani na dalsi zpravu
+static const size_t UrlBatchSize = 64;
+// maximalni velikost davky vysledku stranek posilane z Worker A mastrovi
+static const size_t PageBatchBytes = 1 << 20;
+// Worker A posle davku nejpozdeji po tolika strankach nebo po teto dobe - master stranky hned zapise a hlasi prubeh
+static const size_t ReportBatchPages = 32;
+static const std::chrono::milliseconds ReportInterval{ 500 };
+// archiv stazenych stranek (page_archive.h)
+enum class ArchiveMode {
+    Off,     // stranky se jen stahuji
+    Record,  // stazene stranky se navic pripisuji do archivu
+    Replay   // stranky se ctou z archivu bez pristupu k siti - stranka mimo archiv je jako neuspesne stazeni
+};
+static const ArchiveMode archiveMode = ArchiveMode::Off;
+static const std::string ARCHIVE_DIR = "archive";
+// opakovane obchazeni podminenym GET - validatory a analyzy stranek z predchozich behu (recrawl_cache.h);
+// pouziva se v lokalnich rezimech mimo prehravani archivu
+static const bool incrementalRecrawl = true;
+static const std::string RECRAWL_CACHE_FILE = "results/recrawl.cache";
+// hledani duplicitnich stranek (duplicate_index.h) - duplicita se zapise jen jako alias a jeji odkazy se neprochazeji
+static const bool detectDuplicates = true;
+// rizeni zateze hostitelu (host_scheduler.h) - rychlost, Crawl-delay z robots.txt a soubezne pozadavky na hostitel
+static const bool politeCrawling = UPP_POLITE_CRAWLING;
+// kolikrat se stranka po odpovedi 429/503 zkusi stahnout znovu (po cekani, ktere urci CHostScheduler)
+static const int MaxThrottleRetries = 3;
+// stranky se analyzuji uz behem stahovani (CHtmlStreamScanner); odpoved, ktera neni HTML, se prerusi po hlavickach,
+// delsi nez MaxPageBytes se po MaxPageBytes prerusi a analyzuje se jen jeji zacatek; 0 = bez omezeni
+static const size_t MaxPageBytes = 8 << 20;
+// pocet vlaken formatujicich map.txt a content.txt v lokalnich rezimech
+static const size_t ResultWriterThreads = std::max(1u, std::thread::hardware_concurrency());
 
 // kolikrat se ma provest experiment (a mereni)
 constexpr size_t RunCount = 5;
@@ -66,42 +160,15 @@ void Do_Measure(const std::string& name, void(*fnc)())
     std::cout << "Average time: " << tm << "ms" << std::endl << std::endl;
 }
 
-enum MpiTags {
-    URL_TASK,
-    URL_RESULT,
-    CONTENT_RESULT,
-    TERMINATE
-};
-
- // Структура для зберігання результатів аналізу сторінки
- struct PageAnalysisResult {
-     std::string  url;
-     std::vector<std::string> foundUrls;
-     int imageCount;
-     int linkCount;
-     int formCount;
-     std::vector<std::pair<int, std::string>> headers; // рівень, текст
- };
-
- // Функція для безпечного перетворення URL в назву файлу
- std::string urlToSafeFilename(const std::string& url) {
-     std::string result = url;
-
-     // Видаляємо протокол
-     size_t protocolPos = result.find("://");
-     if (protocolPos != std::string::npos) {
-         result = result.substr(protocolPos + 3);
-     }
-
-     // Заміняємо небезпечні символи на підкреслення
-     for (char& c : result) {
-         if (c == '/' || c == ':' || c == '.' || c == '?' || c == '&' || c == '=' || c == ' ' || c == '#') {
-             c = '_';
-         }
-     }
-
-     return result;
- }
+// Worker B, ktere patri Worker A s rankem workerA podle puvodniho rozdeleni (-n, -m)
+std::vector<int> initialWorkersB(int workerA, int numWorkerA, int numWorkerB) {
+    std::vector<int> workers;
+    int firstWorkerB = (numWorkerB * workerA) - numWorkerB + numWorkerA + 1;
+    for (int i = 0; i < numWorkerB; i++) {
+        workers.push_back(firstWorkerB + i);
+    }
+    return workers;
+}
 
  // Функція для отримання поточної дати/часу у відформатованому вигляді
  std::string getCurrentDateTime() {
@@ -121,198 +188,225 @@ enum MpiTags {
      return ss.str();
  }
 
- // Виокремлення базового URL (для перевірки чи URL відноситься до тієї ж домену і шляху)
- std::string getBaseUrl(const std::string& url) {
-     std::regex urlRegex("(https?://[^/]+(?:/[^/]+)?)");
-     std::smatch match;
-     if (std::regex_search(url, match, urlRegex)) {
-         return match[1];
-     }
-     return url;
- }
-
- // Нормалізація URL відносно базового URL
- std::string normalizeUrl(const std::string& baseUrl, const std::string& url) {
-     if (url.empty()) return "";
-
-     // Якщо це абсолютний URL, повертаємо як є
-     if (url.find("http://") == 0 || url.find("https://") == 0) {
-         return url;
-     }
-
-     std::string result = baseUrl;
-
-     // Видаляємо фрагмент URL
-     size_t fragmentPos = url.find('#');
-     std::string cleanUrl = (fragmentPos != std::string::npos) ? url.substr(0, fragmentPos) : url;
-
-     // Обробка відносних URL
-     if (cleanUrl[0] == '/') {
-         // URL починається зі слеша, це відносний шлях від кореня домену
-         size_t protocolPos = baseUrl.find("://");
-         if (protocolPos != std::string::npos) {
-             size_t pathStart = baseUrl.find('/', protocolPos + 3);
-             if (pathStart != std::string::npos) {
-                 result = baseUrl.substr(0, pathStart);
-             }
-         }
-         result += cleanUrl;
-     } else {
-         // URL не починається зі слеша, це відносний шлях від поточної сторінки
-         if (result.back() != '/') {
-             size_t lastSlash = result.find_last_of('/');
-             if (lastSlash != std::string::npos) {
-                 result = result.substr(0, lastSlash + 1);
-             } else {
-                 result += '/';
-             }
-         }
-         result += cleanUrl;
-     }
-
-     return result;
- }
+// stranka ziskana pro analyzu: HTML, nebo jen priznak, ze se od predchoziho behu nezmenila (odpoved 304)
+struct FetchedPage {
+    std::string html;
+    bool unchanged = false;
+    // validatory odpovedi 200 - ulozi se s analyzou pro pristi podmineny GET
+    std::string etag;
+    std::string lastModified;
+    // prubeh stazeni pro rizeni zateze (viz PageAnalysisResult::httpStatus)
+    int status = 0;
+    uint32_t throttled = 0;
+    uint32_t fetchMs = 0;
+    // tagy naskenovane behem stahovani - analyzePage je uz neskenuje znovu
+    bool scanned = false;
+    HtmlScanResult scan;
+
+    // stranku se nepodarilo ziskat
+    bool Empty() const { return html.empty() && !unchanged; }
+};
 
- // Функція для перевірки чи URL належить до тієї ж домену і шляху
- bool isSameDomain(const std::string& baseUrl, const std::string& url) {
-     return url.find(baseUrl) == 0;
- }
+// rizeni zateze hostitelu se pri prehravani archivu nepouziva - na sit se nic neposila
+bool scheduleHosts() {
+    return politeCrawling && archiveMode != ArchiveMode::Replay;
+}
 
-int calculateImgHtml(const std::regex& imgRegex, const std::string& html) {
-     auto imgBegin = std::sregex_iterator(html.begin(), html.end(), imgRegex);
-     auto imgEnd = std::sregex_iterator();
-     return std::distance(imgBegin, imgEnd);
- }
+// prelozi host URL na pozadi, aby na DNS necekalo az prvni stazeni (pri prehravani archivu se na sit nepristupuje)
+void prefetchHost(const std::string& url) {
+    if (archiveMode != ArchiveMode::Replay) {
+        CDnsCache::Instance().Prefetch(hostName(parseUrl(url).authority));
+    }
+}
 
-int calculateFormHtml(const std::regex& formRegex, const std::string& html) {
-     auto formBegin = std::sregex_iterator(html.begin(), html.end(), formRegex);
-     auto formEnd = std::sregex_iterator();
-     return std::distance(formBegin, formEnd);
- }
+// robots.txt hostitele pro Crawl-delay (CHostScheduler::Set_Robots_Loader)
+std::string loadRobots(const std::string& origin) {
+    utils::HttpPage robots = utils::downloadPage(origin + "/robots.txt", "", "");
+    return robots.status == 200 ? std::move(robots.body) : "";
+}
 
-std::pair<int, std::vector<std::string>> urlProcessingHtml(const std::regex& linkRegex,const std::string& html, const std::string& baseUrl) {
-     auto linkBegin = std::sregex_iterator(html.begin(), html.end(), linkRegex);
-     auto linkEnd = std::sregex_iterator();
-     int numberOfLinks = std::distance(linkBegin, linkEnd);
+// stranka podle archiveMode - ze site, ze site s archivaci, nebo z archivu; vsechny rezimy obchazeni
+// (i Worker B) ziskavaji stranky jen pres tuto funkci. Stranky ze site se stahuji podminenym GET
+// s validatory z CRecrawlCache (pokud je cache nactena) a s rizenim zateze hostitele (CHostScheduler)
+FetchedPage fetchPage(const std::string& url) {
+    FetchedPage page;
+    if (archiveMode == ArchiveMode::Replay) {
+        static CPageArchiveReader archive;
+        static bool opened = [] {
+            std::string error;
+            if (!archive.Open(ARCHIVE_DIR, error)) {
+                std::cerr << "Archiv: " << error << std::endl;
+                return false;
+            }
+            std::cout << "Archiv: prehravani " << archive.Size() << " stranek z " << ARCHIVE_DIR << std::endl;
+            return true;
+        }();
+        if (opened) {
+            page.html = archive.Find(url);
+            page.status = page.html.empty() ? 404 : 200;
+        }
+        return page;
+    }
 
-     std::cout << "Seznam odkazů nalezených na zadané url adrese" << std::endl;
-     std::vector<std::string> links;
-     for (std::sregex_iterator i = linkBegin; i != linkEnd; ++i) {
-         std::smatch match = *i;
-         std::string href = match[1];
-         std::string normalizedUrl = normalizeUrl(baseUrl, href);
+    std::string etag;
+    std::string lastModified;
+    CRecrawlCache::Instance().Get_Validators(url, etag, lastModified);
+
+    std::string origin = getOrigin(url);
+    CHostScheduler& scheduler = CHostScheduler::Instance();
+    auto fetchStart = std::chrono::steady_clock::now();
+    utils::HttpPage response;
+    std::optional<CHtmlStreamScanner> scanner;
+    for (int attempt = 0; ; attempt++) {
+        if (scheduleHosts()) {
+            scheduler.Acquire(origin);
+        }
+        auto start = std::chrono::steady_clock::now();
+        // kazdy pokus skenuje od zacatku - telo odmitnute odpovedi se scanneru nepreda
+        scanner.emplace();
+        utils::BodySink sink{ MaxPageBytes, true, [&scanner](std::string_view chunk) { scanner->Append(chunk); } };
+        response = utils::downloadPage(url, etag, lastModified, &sink);
+        if (!scheduleHosts()) {
+            break;
+        }
+        scheduler.Release(origin, { response.status, 0, std::chrono::steady_clock::now() - start, std::chrono::seconds(response.retryAfter) });
 
-         std::cout << "Cesta ke zdroji URI " << href << std::endl;
-         std::cout << "Úplná adresa nalezené stránky " << normalizedUrl << std::endl;
+        bool throttled = response.status == 429 || response.status == 503;
+        if (!throttled || attempt == MaxThrottleRetries) {
+            break;
+        }
+        // dalsi Acquire pocka do konce Retry-After
+        page.throttled++;
+        std::cerr << "Hostitel " << origin << " odmítl " << url << " (" << response.status << "), opakování " << attempt + 1 << std::endl;
+    }
+    page.status = response.status;
+    page.fetchMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - fetchStart).count());
 
-         if (!normalizedUrl.empty() && isSameDomain(baseUrl, normalizedUrl)) {
-             links.push_back(normalizedUrl);
-         }
-     }
+    if (response.status == 304) {
+        page.unchanged = true;
+        return page;
+    }
+    if (response.status != 200) {
+        return page;
+    }
+    if (response.notHtml) {
+        std::cerr << "Přeskočeno " << url << " - odpověď není HTML" << std::endl;
+        return page;
+    }
+    if (response.truncated) {
+        std::cerr << "Stránka " << url << " je delší než " << MaxPageBytes << " B - analyzuje se jen začátek" << std::endl;
+    }
+    // zbytek dokumentu se doskenuje hned - analyza pak uz jen zpracuje nalezene tagy
+    scanner->Finish();
+    page.html = scanner->Take_Document();
+    page.scan = std::move(scanner->Result());
+    page.scanned = true;
+    page.etag = std::move(response.etag);
+    page.lastModified = std::move(response.lastModified);
+
+    // neuspesna stazeni se neukladaji - pri prehravani dopadnou stejne
+    if (archiveMode == ArchiveMode::Record && !page.html.empty()) {
+        static CPageArchiveWriter archive(ARCHIVE_DIR);
+        archive.Append(url, page.html);
+    }
+    return page;
+}
 
-     return std::make_pair(numberOfLinks, links);
- }
+// analyza ziskane stranky; nezmenena stranka pouzije ulozenou analyzu, nova analyza se ulozi pro pristi beh.
+// Tagy naskenovane uz pri stahovani (page.scan) se presunou do vysledku, otisky obsahu jen s detectDuplicates
+PageAnalysisResult analyzePage(const std::string& url, FetchedPage& page) {
+    PageAnalysisResult result;
+    if (!page.unchanged || !CRecrawlCache::Instance().Reuse(url, result)) {
+        result = page.scanned ? analyzeScannedHtml(url, std::move(page.scan)) : analyzeHtml(url, page.html);
+        // otisky se bez hledani duplicit nepocitaji (simHash je radove drazsi nez skenovani stranky)
+        if (detectDuplicates) {
+            result.contentHash = contentHash(page.html);
+            result.simHash = simHash(page.html);
+        }
+        CRecrawlCache::Instance().Store(url, page.etag, page.lastModified, result);
+    }
+    result.httpStatus = page.status;
+    result.throttledResponses = page.throttled;
+    result.fetchMs = page.fetchMs;
+    return result;
+}
 
- // Функція для аналізу HTML-контенту
- PageAnalysisResult analyzeHtml(const std::string& url, const std::string& html) {
-     PageAnalysisResult result;
-     result.url = url;
-     result.imageCount = 0;
-     result.linkCount = 0;
-     result.formCount = 0;
-
-     std::string baseUrl = getBaseUrl(url);
-     std::cout << "url: " << url << "; baseUrl:" << baseUrl << std::endl;
-
-     // Регулярні вирази для пошуку елементів
-     std::regex imgRegex("<img[^>]*>");
-     std::regex linkRegex("<a[^>]*href=[\"']([^\"']+)[\"'][^>]*>");
-     std::regex formRegex("<form[^>]*>");
-     std::regex headerRegex("<h([1-6])[^>]*>(.*?)</h\\1>");
-
-     // Підрахунок зображень
-     result.imageCount = calculateImgHtml(imgRegex, html);
-
-     // Підрахунок посилань та збір URL
-     std::pair<int, std::vector<std::string>> urlProcessing = urlProcessingHtml(linkRegex, html, baseUrl);
-     result.linkCount = urlProcessing.first;
-     result.foundUrls = urlProcessing.second;
-
-     // Підрахунок форм
-     result.formCount = calculateFormHtml(formRegex, html);
-
-     // Аналіз заголовків
-     std::string::const_iterator searchStart(html.cbegin());
-     std::smatch headerMatch;
-     while (std::regex_search(searchStart, html.cend(), headerMatch, headerRegex)) {
-         int level = std::stoi(headerMatch[1]);
-         std::string headerText = headerMatch[2];
-
-         // Очищення тексту заголовка від тегів
-         std::regex tagRegex("<[^>]*>");
-         headerText = std::regex_replace(headerText, tagRegex, "");
-
-         result.headers.push_back({level, headerText});
-         searchStart = headerMatch.suffix().first;
-     }
+// duplicitni stranka (viz detectDuplicates) se zmeni na alias a jeji odkazy se zapocitaji jako preskocene;
+// isNew - odkaz by se jinak zaradil k obchazeni. Vraci true pro duplicitu
+bool skipDuplicate(CDuplicateIndex& duplicates, PageAnalysisResult& analysis, const std::function<bool(const std::string&)>& isNew) {
+    if (!detectDuplicates) {
+        return false;
+    }
+    std::optional<std::string> canonical = duplicates.Find_Or_Add(analysis);
+    if (!canonical) {
+        return false;
+    }
+    std::cout << "Duplicitní stránka " << analysis.url << " (stejná jako " << *canonical << ")" << std::endl;
+    duplicates.Skip_Links(analysis, isNew);
+    makeAlias(analysis, std::move(*canonical));
+    return true;
+}
 
-     return result;
- }
+void printDuplicateStats(std::ostream& os, const CDuplicateIndex& duplicates) {
+    CDuplicateIndex::Stats stats = duplicates.Get_Stats();
+    os << "Duplicity: přesné " << stats.exactDuplicates << ", téměř shodné " << stats.nearDuplicates
+       << ", přeskočených odkazů " << stats.skippedLinks << ", ušetřených stažení a analýz " << stats.avoidedFetches << std::endl;
+}
 
-void printVisitedUrls(std::queue<std::string> visitedUrls) {
-     int index = 1;
-     while (!visitedUrls.empty()) {
-         std::cout << "[" << index++ << "] " << visitedUrls.front() << std::endl;
-         visitedUrls.pop();
-     }
+void printVisitedUrls(const CCrawlFrontier& frontier) {
+     frontier.Print_Queue(std::cout);
  }
 
 
  // Серійна функція для краулінгу
- void serialCrawl(const std::string& startUrl, std::unordered_map<std::string, PageAnalysisResult>& results) {
+ void serialCrawl(const std::string& startUrl, CResultStore& results) {
      auto overallStart = std::chrono::high_resolution_clock::now();
-     std::queue<std::string> urlQueue;
-     std::unordered_set<std::string> visitedUrls;
+     // fronta spolu s mnozinou navstivenych URL (viz visitedSetMode)
+     CCrawlFrontier frontier(visitedSetMode);
+     CDuplicateIndex duplicates;
      std::string baseUrl = getBaseUrl(startUrl);
 
-     urlQueue.push(startUrl);
-     visitedUrls.insert(startUrl);
+     frontier.Push_If_New(startUrl);
 
      int counter = 0;
      unsigned long long tmDownload = 0;
      unsigned long long tmAnalyze = 0;
 
-     while (!urlQueue.empty()) {
-         std::string currentUrl = urlQueue.front();
-         urlQueue.pop();
+     while (!frontier.Empty()) {
+         std::string currentUrl = frontier.Pop();
          counter++;
          std::cout << "Zahájení zkoumání stránky (serial) z url " << currentUrl << std::endl;
 
          // Завантаження HTML
          auto start = std::chrono::high_resolution_clock::now();
-         std::string html = utils::downloadHTML(currentUrl);
+         FetchedPage page = fetchPage(currentUrl);
          auto end = std::chrono::high_resolution_clock::now();
          auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
          tmDownload += elapsed.count();
-         if (html.empty()) continue;
+         if (page.Empty()) continue;
 
          // Аналіз сторінки
          auto start1 = std::chrono::high_resolution_clock::now();
-         PageAnalysisResult analysis = analyzeHtml(currentUrl, html);
+         PageAnalysisResult analysis = analyzePage(currentUrl, page);
          auto end1 = std::chrono::high_resolution_clock::now();
          auto elapsed1 = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1);
          tmAnalyze += elapsed1.count();
 
-         results[currentUrl] = analysis;
+         if (skipDuplicate(duplicates, analysis, [&](const std::string& url) { return isSameDomain(baseUrl, url) && !frontier.Contains(url); })) {
+             results.Add(currentUrl, analysis);
+             continue;
+         }
 
          // Додавання нових URL в чергу
+         // Push_If_New prida jen dosud nenavstivenou URL
          for (const auto& url : analysis.foundUrls) {
-             if (visitedUrls.find(url) == visitedUrls.end() && isSameDomain(baseUrl, url)) {
-                 urlQueue.push(url);
-                 visitedUrls.insert(url);
+             if (isSameDomain(baseUrl, url)) {
+                 frontier.Push_If_New(url);
              }
          }
-         printVisitedUrls(urlQueue);
+
+         results.Add(currentUrl, analysis);
+         printVisitedUrls(frontier);
      }
      auto overallEnd = std::chrono::high_resolution_clock::now();
      auto overallElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(overallEnd - overallStart);
@@ -322,45 +416,287 @@ void printVisitedUrls(std::queue<std::string> visitedUrls) {
      // tmAnalyze /= counter;
      std::cout << "Průměrná doba provedení operace analýzy obsahu stránky: " << tmAnalyze << " ms"<< std::endl;
      std::cout << "Průměrný čas pro provedení operace načtení obsahu stránky: " << tmDownload << " ms" << std::endl;
+     frontier.Print_Stats(std::cout);
+     printDuplicateStats(std::cout, duplicates);
+
+     CConnectionPool::Stats poolStats = CConnectionPool::Instance().Get_Stats();
+     std::cout << "Pool spojení: znovupoužito " << poolStats.hits << ", nově otevřeno " << poolStats.misses
+               << ", zavřeno " << poolStats.evictions << ", nečinných " << poolStats.idle << std::endl;
+     CDnsCache::Instance().Print_Stats(std::cout);
+     CHostScheduler::Instance().Print_Stats(std::cout);
  }
 
-void createWebGraph(const auto& resultDir, const auto& results) {
-     std::ofstream mapFile(resultDir + MAP_FILE_NAME);
+ // Конвеєрний краулінг: пул потоків завантажує сторінки, поки головний потік аналізує вже завантажені
+ void pipelinedCrawl(const std::string& startUrl, CResultStore& results, size_t numFetchers) {
+     auto overallStart = std::chrono::high_resolution_clock::now();
+     std::queue<std::string> urlQueue;
+     std::unordered_set<std::string> visitedUrls;
+     CDuplicateIndex duplicates;
+     std::string baseUrl = getBaseUrl(startUrl);
 
-     // Запис вузлів графа
-     for (const auto& pair : results) {
-         mapFile << pair.first << std::endl;
+     // Черги між етапами: URL до завантажувачів, завантажені сторінки до аналізу
+     BoundedQueue<std::string> fetchQueue(PipelineQueueCapacity);
+     BoundedQueue<std::pair<std::string, FetchedPage>> pageQueue(PipelineQueueCapacity);
+     CStageTimer stageTimer;
+
+     std::atomic<unsigned long long> tmDownload{ 0 };
+     unsigned long long tmAnalyze = 0;
+
+     std::vector<std::thread> fetchers;
+     for (size_t i = 0; i < numFetchers; i++) {
+         fetchers.emplace_back([&]() {
+             while (std::optional<std::string> currentUrl = fetchQueue.Pop()) {
+                 auto start = std::chrono::high_resolution_clock::now();
+                 stageTimer.Begin_Download();
+                 FetchedPage page = fetchPage(*currentUrl);
+                 stageTimer.End_Download();
+                 auto end = std::chrono::high_resolution_clock::now();
+                 tmDownload += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+                 // і порожня сторінка йде далі, щоб аналіз знав, що завантаження закінчилось
+                 pageQueue.Push({ std::move(*currentUrl), std::move(page) });
+             }
+         });
      }
 
-     // Запис ребер графа
-     for (const auto& pair : results) {
-         const std::string& sourceUrl = pair.first;
-         for (const std::string& targetUrl : pair.second.foundUrls) {
-             if (results.find(targetUrl) != results.end()) {
-                 mapFile << sourceUrl << " " << targetUrl << std::endl;
+     urlQueue.push(startUrl);
+     visitedUrls.insert(startUrl);
+
+     // кількість URL, які вже передані завантажувачам і ще не повернулись на аналіз
+     size_t inFlight = 0;
+
+     while (true) {
+         // Передаємо завантажувачам стільки URL, скільки поміститься в чергу, без блокування
+         while (!urlQueue.empty() && fetchQueue.Try_Push(urlQueue.front())) {
+             urlQueue.pop();
+             inFlight++;
+         }
+
+         if (inFlight == 0) {
+             break;
+         }
+
+         std::optional<std::pair<std::string, FetchedPage>> page = pageQueue.Pop();
+         inFlight--;
+
+         const std::string& currentUrl = page->first;
+         FetchedPage& fetched = page->second;
+         std::cout << "Zahájení zkoumání stránky (pipeline) z url " << currentUrl << std::endl;
+         if (fetched.Empty()) continue;
+
+         // Аналіз сторінки
+         auto start1 = std::chrono::high_resolution_clock::now();
+         stageTimer.Begin_Analyze();
+         PageAnalysisResult analysis = analyzePage(currentUrl, fetched);
+         stageTimer.End_Analyze();
+         auto end1 = std::chrono::high_resolution_clock::now();
+         auto elapsed1 = std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1);
+         tmAnalyze += elapsed1.count();
+
+         if (skipDuplicate(duplicates, analysis, [&](const std::string& url) { return visitedUrls.find(url) == visitedUrls.end() && isSameDomain(baseUrl, url); })) {
+             results.Add(currentUrl, analysis);
+             continue;
+         }
+
+         // Додавання нових URL в чергу
+         for (const auto& url : analysis.foundUrls) {
+             if (visitedUrls.find(url) == visitedUrls.end() && isSameDomain(baseUrl, url)) {
+                 urlQueue.push(url);
+                 visitedUrls.insert(url);
              }
          }
+
+         results.Add(currentUrl, analysis);
+     }
+
+     fetchQueue.Close();
+     for (auto& fetcher : fetchers) {
+         fetcher.join();
+     }
+
+     CStageTimer::Stats stages = stageTimer.Finish();
+     auto toMs = [](CStageTimer::Clock::duration d) { return std::chrono::duration_cast<std::chrono::milliseconds>(d).count(); };
+
+     auto overallEnd = std::chrono::high_resolution_clock::now();
+     auto overallElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(overallEnd - overallStart);
+     std::cout << "Celkový čas provedení funkce pipelinedCrawl (" << numFetchers << " vláken stahování): " << overallElapsed.count() << " ms" << std::endl;
+
+     std::cout << "Průměrná doba provedení operace analýzy obsahu stránky: " << tmAnalyze << " ms"<< std::endl;
+     std::cout << "Průměrný čas pro provedení operace načtení obsahu stránky: " << tmDownload << " ms" << std::endl;
+     std::cout << "Souběh stahování a analýzy: " << toMs(stages.overlap) << " ms, pouze stahování: " << toMs(stages.downloadOnly)
+               << " ms, pouze analýza: " << toMs(stages.analyzeOnly) << " ms, nečinnost: " << toMs(stages.idle) << " ms" << std::endl;
+     if (stages.overlap + stages.analyzeOnly > CStageTimer::Clock::duration::zero()) {
+         std::cout << "Analýza překrytá stahováním: " << (100 * toMs(stages.overlap) / std::max<long long>(1, toMs(stages.overlap + stages.analyzeOnly))) << " %" << std::endl;
      }
-     mapFile.close();
+     printDuplicateStats(std::cout, duplicates);
+
+     CConnectionPool::Stats poolStats = CConnectionPool::Instance().Get_Stats();
+     std::cout << "Pool spojení: znovupoužito " << poolStats.hits << ", nově otevřeno " << poolStats.misses
+               << ", zavřeno " << poolStats.evictions << ", nečinných " << poolStats.idle << std::endl;
+     CDnsCache::Instance().Print_Stats(std::cout);
+     CHostScheduler::Instance().Print_Stats(std::cout);
  }
 
-void createContent(const auto& resultDir, const auto& results) {
-     std::ofstream contentFile(resultDir + CONTENT_FILE_NAME);
-     for (const auto& pair : results) {
-         contentFile << pair.first << std::endl;
-         contentFile << "IMAGES " << pair.second.imageCount << std::endl;
-         contentFile << "LINKS " << pair.second.linkCount << std::endl;
-         contentFile << "FORMS " << pair.second.formCount << std::endl;
-
-         for (const auto& header : pair.second.headers) {
-             for (int i = 0; i < header.first; i++) {
-                 contentFile << "-";
+ // otisky obsahu stranky z analyzePage; workStealingCrawl je uklada pro kazde vlakno podle indexu stranky v jeho CResultStore
+ struct PageFingerprint {
+     uint64_t contentHash;
+     uint64_t simHash;
+ };
+
+ // Вставляє результати в тому порядку, в якому їх вставив би serialCrawl (обхід у ширину від startUrl).
+ // CResultStore зберігає порядок вставки, тому map.txt і content.txt будуть однакові.
+ // Duplicity se rozhoduji az tady v tomto poradi, jako v serialCrawl: kanonickou strankou je kopie, ktera je v obchodu
+ // do sirky prvni, ne ta, kterou nektere vlakno stahlo driv; odkazy duplicity se neprochazeji
+ void insertInCrawlOrder(const std::string& startUrl, const std::vector<CResultStore>& crawled, const std::vector<std::vector<PageFingerprint>>& fingerprints,
+                         CDuplicateIndex& duplicates, CResultStore& results) {
+     std::queue<std::string> urlQueue;
+     CUrlTable visitedUrls;
+     std::string baseUrl = getBaseUrl(startUrl);
+
+     urlQueue.push(startUrl);
+     visitedUrls.Intern(startUrl);
+
+     while (!urlQueue.empty()) {
+         std::string currentUrl = std::move(urlQueue.front());
+         urlQueue.pop();
+
+         // сторінка є у сховищі потоку, який її обробив; сторінок, які не вдалося завантажити, немає ніде
+         size_t thread = 0;
+         std::optional<CResultStore::PageIndex> page;
+         for (; thread < crawled.size(); thread++) {
+             page = crawled[thread].Find(currentUrl);
+             if (page) {
+                 break;
              }
-             contentFile << " " << header.second << std::endl;
          }
-         contentFile << std::endl;
+         if (!page) continue;
+         const CResultStore& store = crawled[thread];
+
+         if (detectDuplicates) {
+             PageAnalysisResult analysis = store.Materialize(*page);
+             analysis.contentHash = fingerprints[thread][*page].contentHash;
+             analysis.simHash = fingerprints[thread][*page].simHash;
+             // vlakna uz stahla a analyzovala i stranky za odkazy duplicit - zapocitaji se jen preskocene odkazy,
+             // zadne usetrene stazeni
+             if (skipDuplicate(duplicates, analysis, [](const std::string&) { return false; })) {
+                 results.Add(currentUrl, analysis);
+                 continue;
+             }
+         }
+
+         for (UrlId link : store.Links(*page)) {
+             std::string url(store.Url_Text(link));
+             if (isSameDomain(baseUrl, url) && visitedUrls.Intern(url).second) {
+                 urlQueue.push(std::move(url));
+             }
+         }
+
+         results.Add(store, *page);
      }
-     contentFile.close();
+ }
+
+ // Паралельний краулінг у спільній пам'яті: кожен потік має власну чергу і краде роботу в інших, коли своя порожня
+ void workStealingCrawl(const std::string& startUrl, CResultStore& results, size_t numThreads) {
+     auto overallStart = std::chrono::high_resolution_clock::now();
+     std::string baseUrl = getBaseUrl(startUrl);
+
+     std::vector<WorkStealingDeque<std::string>> queues(numThreads);
+     CConcurrentUrlSet visitedUrls;
+     // результати кожного потоку окремо, щоб не потрібен був спільний замок
+     std::vector<CResultStore> threadResults(numThreads);
+     // duplicity rozhodne az insertInCrawlOrder - vlakna prochazeji i odkazy duplicit, za cenu stazeni stranek,
+     // ktere serialCrawl preskoci, je ale vystup stejny pri kazdem behu
+     std::vector<std::vector<PageFingerprint>> threadFingerprints(numThreads);
+     CDuplicateIndex duplicates;
+
+     // кількість URL, які вже в чергах або ще обробляються; 0 означає кінець обходу
+     std::atomic<size_t> pending{ 1 };
+     std::atomic<unsigned long long> tmDownload{ 0 };
+     std::atomic<unsigned long long> tmAnalyze{ 0 };
+     std::atomic<size_t> steals{ 0 };
+
+     queues[0].Push_Bottom(startUrl);
+     visitedUrls.Insert(startUrl);
+
+     auto worker = [&](size_t id) {
+         while (true) {
+             std::optional<std::string> currentUrl = queues[id].Pop_Bottom();
+
+             // vlastni fronta je prazdna - zkusime ukrast nejstarsi URL jinemu vlaknu
+             for (size_t k = 1; !currentUrl && k < numThreads; k++) {
+                 currentUrl = queues[(id + k) % numThreads].Steal_Top();
+                 if (currentUrl) {
+                     steals++;
+                 }
+             }
+
+             if (!currentUrl) {
+                 if (pending.load() == 0) {
+                     break;
+                 }
+                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                 continue;
+             }
+
+             std::cout << "Zahájení zkoumání stránky (vlákno " << id << ") z url " << *currentUrl << std::endl;
+
+             auto start = std::chrono::high_resolution_clock::now();
+             FetchedPage page = fetchPage(*currentUrl);
+             auto end = std::chrono::high_resolution_clock::now();
+             tmDownload += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+             if (!page.Empty()) {
+                 auto start1 = std::chrono::high_resolution_clock::now();
+                 PageAnalysisResult analysis = analyzePage(*currentUrl, page);
+                 auto end1 = std::chrono::high_resolution_clock::now();
+                 tmAnalyze += std::chrono::duration_cast<std::chrono::milliseconds>(end1 - start1).count();
+
+                 // Додавання нових URL у власну чергу
+                 for (const auto& url : analysis.foundUrls) {
+                     if (isSameDomain(baseUrl, url) && visitedUrls.Insert(url)) {
+                         pending++;
+                         queues[id].Push_Bottom(url);
+                     }
+                 }
+
+                 threadResults[id].Add(*currentUrl, analysis);
+                 threadFingerprints[id].push_back({ analysis.contentHash, analysis.simHash });
+             }
+
+             // az po pridani novych URL, jinak by ostatni vlakna mohla skoncit predcasne
+             pending--;
+         }
+     };
+
+     std::vector<std::thread> threads;
+     for (size_t i = 0; i < numThreads; i++) {
+         threads.emplace_back(worker, i);
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+
+     insertInCrawlOrder(startUrl, threadResults, threadFingerprints, duplicates, results);
+
+     auto overallEnd = std::chrono::high_resolution_clock::now();
+     auto overallElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(overallEnd - overallStart);
+     std::cout << "Celkový čas provedení funkce workStealingCrawl (" << numThreads << " vláken): " << overallElapsed.count() << " ms" << std::endl;
+
+     std::cout << "Průměrná doba provedení operace analýzy obsahu stránky: " << tmAnalyze << " ms"<< std::endl;
+     std::cout << "Průměrný čas pro provedení operace načtení obsahu stránky: " << tmDownload << " ms" << std::endl;
+     std::cout << "Navštíveno URL: " << visitedUrls.Size() << ", ukradených úloh: " << steals << std::endl;
+     printDuplicateStats(std::cout, duplicates);
+     CDnsCache::Instance().Print_Stats(std::cout);
+     CHostScheduler::Instance().Print_Stats(std::cout);
+ }
+
+// zapis map.txt a content.txt formatuje stranky paralelne v poradi obchazeni (result_writer.h)
+void createWebGraph(const auto& resultDir, const auto& results) {
+     writeWebGraph(resultDir, results, ResultWriterThreads);
+ }
+
+void createContent(const auto& resultDir, const auto& results) {
+     writeContent(resultDir, results, ResultWriterThreads);
  }
 
 void createLog(const auto& resultDir, const auto& results, const auto& startTime) {
@@ -381,17 +717,58 @@ void createLog(const auto& resultDir, const auto& results, const auto& startTime
      // Створення каталогу для результатів
      std::filesystem::create_directory("results");
 
+     bool useRecrawlCache = incrementalRecrawl && archiveMode != ArchiveMode::Replay;
+     if (useRecrawlCache) {
+         // cache se nacte jen jednou za beh programu, pri kazdem zpracovani se uklada
+         static std::once_flag cacheLoaded;
+         std::call_once(cacheLoaded, [] {
+             if (!CRecrawlCache::Instance().Load(RECRAWL_CACHE_FILE)) {
+                 std::cerr << "Poškozená cache " << RECRAWL_CACHE_FILE << " - stránky se stáhnou celé" << std::endl;
+             }
+             std::cout << "Cache podmíněného GET: " << CRecrawlCache::Instance().Size() << " stránek" << std::endl;
+         });
+     }
+     if (scheduleHosts()) {
+         CHostScheduler::Instance().Set_Robots_Loader(loadRobots);
+     }
+     // domeny se obchazi jedna po druhe - hosty dalsich se prelozi, zatimco se obchazi prvni
+     for (const auto& url : URLs) {
+         prefetchHost(url);
+     }
+
      // Обробка кожного URL
      for (const auto& url : URLs) {
          static std::string curr_url = url;
-         static std::unordered_map<std::string, PageAnalysisResult> results;
+         static CResultStore results;
+         size_t pagesBefore = results.Size();
+         CRecrawlCache::Stats recrawlBefore = CRecrawlCache::Instance().Get_Stats();
 
         //  Виконання краулінгу
         //  Do_Measure("Crawling " + url, []() {
         //     serialCrawl(curr_url, results);
         // });
 
-         serialCrawl(url, results);
+         switch (localCrawlMode) {
+             case CrawlMode::Pipelined:
+                 pipelinedCrawl(url, results, PipelineFetchers);
+                 break;
+             case CrawlMode::WorkStealing:
+                 workStealingCrawl(url, results, std::max(2u, std::thread::hardware_concurrency()));
+                 break;
+             default:
+                 serialCrawl(url, results);
+                 break;
+         }
+         if (useRecrawlCache) {
+             CRecrawlCache::Stats recrawl = CRecrawlCache::Instance().Get_Stats();
+             std::cout << "Podmíněný GET: znovu ověřeno (304) " << recrawl.revalidated - recrawlBefore.revalidated
+                       << ", staženo celých " << recrawl.refetched - recrawlBefore.refetched << std::endl;
+         }
+         // lokalni rezimy hlasi prubeh az po cele domene
+         CCrawlProgress::Instance().Pages_Done(results.Size() - pagesBefore);
+         std::cout << "Výsledky: " << results.Size() << " stránek, " << results.Memory_Usage() / std::max<size_t>(1, results.Size())
+                   << " B na stránku" << std::endl;
+         CCrawlProgress::Instance().Domain_Done();
 
          // Створення каталогу для результатів цього URL
          std::string safeUrlName = urlToSafeFilename(url);
@@ -422,424 +799,697 @@ void createLog(const auto& resultDir, const auto& results, const auto& startTime
      }
 
      vystup += "</ul>";
+     if (useRecrawlCache && !CRecrawlCache::Instance().Save(RECRAWL_CACHE_FILE)) {
+         std::cerr << "Nelze zapsat cache " << RECRAWL_CACHE_FILE << std::endl;
+     }
      auto end = std::chrono::system_clock::now();
      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();;
      std::cout << "Total time: " << elapsed << " ms" << std::endl;
  }
 
 
- // Майстер процес - розподіляє роботу і збирає результати
-void masterProcess(const std::vector<std::string>& URLs, int numWorkerA, int numWorkerB, std::string& output) {
-    int numUrls = URLs.size();
+ // Master: prijme davku stranek (PAGE_BATCH zjistenou pres MPI_Probe) a stranky hned zapise;
+ // vraci false pro prazdnou davku = Worker A dokoncil domenu
+bool receivePageBatch(MPI_Status& probed, CResultWriter& writer, std::vector<char>& buffer, std::vector<PageAnalysisResult>& pages) {
+    int batchSize;
+    MPI_Get_count(&probed, MPI_CHAR, &batchSize);
+    buffer.resize(batchSize);
+    MPI_Recv(buffer.data(), batchSize, MPI_CHAR, probed.MPI_SOURCE, PAGE_BATCH, MPI_COMM_WORLD, &probed);
+    if (batchSize == 0) {
+        return false;
+    }
 
-    // Перевіряємо, чи є що розподіляти
-    if (numUrls == 0) {
-        output = "<h2>Немає URL для обробки</h2>";
+    pages.clear();
+    // z poskozene davky se zapisi jen cele dekodovane stranky pred poskozenym mistem
+    if (!decodePages(buffer.data(), buffer.size(), pages)) {
+        std::cerr << "Master: Malformed page batch from worker A " << probed.MPI_SOURCE << ", keeping " << pages.size() << " decoded pages" << std::endl;
+    }
 
-        // Повідомляємо всім воркерам A про завершення
-        for (int i = 1; i <= numWorkerA; ++i) {
-            int terminate = -1;
-            MPI_Send(&terminate, 1, MPI_INT, i, URL_TASK, MPI_COMM_WORLD);
+    size_t added = 0;
+    for (const auto& page : pages) {
+        if (writer.Add_Page(page)) {
+            added++;
         }
-        return;
     }
+    writer.Flush();
+    CCrawlProgress::Instance().Pages_Done(added);
+    return true;
+}
 
-    std::string startTime = getLogDateTime();
-    std::cout << "Master: Starting processing " << numUrls << " URLs" << std::endl;
-
-    // Розподіл URL між воркерами A
-    for (int i = 0; i < numUrls; ++i) {
-        int workerA = (i % numWorkerA) + 1; // Worker A має ID від 1 до N
-
-        // Відправка URL до воркера A
-        std::string url = URLs[i];
-        int urlLength = url.length();
+ // Master: prijme pocet URL ve fronte Worker A (QUEUE_STATUS zjistenou pres MPI_Probe)
+uint64_t receiveQueueStatus(MPI_Status& probed) {
+    uint64_t depth;
+    MPI_Recv(&depth, 1, MPI_UINT64_T, probed.MPI_SOURCE, QUEUE_STATUS, MPI_COMM_WORLD, &probed);
+    return depth;
+}
 
-        std::cout << "Master: Sending URL to worker A " << workerA << ": " << url << std::endl;
+ // prijme a zahodi neocekavanou zpravu, aby neblokovala frontu zprav
+void discardMessage(MPI_Status& probed) {
+    int size;
+    MPI_Get_count(&probed, MPI_BYTE, &size);
+    std::vector<char> buffer(size);
+    MPI_Recv(buffer.data(), size, MPI_BYTE, probed.MPI_SOURCE, probed.MPI_TAG, MPI_COMM_WORLD, &probed);
+}
 
-        MPI_Send(&urlLength, 1, MPI_INT, workerA, URL_TASK, MPI_COMM_WORLD);
-        MPI_Send(url.c_str(), urlLength, MPI_CHAR, workerA, URL_TASK, MPI_COMM_WORLD);
+// MPI_Probe s casovym limitem - Worker A ceka na zpravu jen do chvile, kdy CHostScheduler povoli dalsi pozadavek;
+// timeout Clock::duration::max() = cekat bez limitu. Vraci false, pokud do limitu zadna zprava neprisla
+bool probeMessage(MPI_Status& probed, CHostScheduler::Clock::duration timeout) {
+    if (timeout == CHostScheduler::Clock::duration::max()) {
+        MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probed);
+        return true;
     }
+    auto deadline = CHostScheduler::Clock::now() + timeout;
+    while (true) {
+        int flag = 0;
+        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &probed);
+        if (flag) {
+            return true;
+        }
+        if (CHostScheduler::Clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
 
-    // Повідомлення всім воркерам A про завершення розподілу задач
-    for (int i = 1; i <= numWorkerA; ++i) {
-        int terminate = -1;
-        std::cout << "Master: Sending termination signal to worker A " << i << std::endl;
-        MPI_Send(&terminate, 1, MPI_INT, i, URL_TASK, MPI_COMM_WORLD);
+// Worker A: smi prave prirazovana URL jit na hostitel? Pri odmitnuti vrati ve wait, kdy to zkusit znovu
+bool acquireHost(CHostScheduler& scheduler, const std::string& origin, CHostScheduler::Clock::duration& wait) {
+    return !scheduleHosts() || scheduler.Try_Acquire(origin, wait);
+}
+
+// Worker A: vysledek od Worker B uzavira pozadavek na hostitel
+void releaseHost(CHostScheduler& scheduler, const std::string& origin, const PageAnalysisResult& result) {
+    if (scheduleHosts()) {
+        scheduler.Release(origin, { result.httpStatus, result.throttledResponses, std::chrono::milliseconds(result.fetchMs) });
     }
+}
 
-    // Створення каталогу для результатів
+ // Master v rezimu SharedDomain - domeny jedna po druhe, kazdou obchazi vsichni Worker A spolecne
+void masterSharedDomains(const std::vector<std::string>& URLs, int numWorkerA, const std::string& startTime, std::string& output) {
     std::filesystem::create_directory("results");
-
-    // Отримання результатів від воркерів A
     output = "<h2>Результати краулінгу</h2><ul>";
 
-    for (int i = 0; i < numUrls; ++i) {
-        // Отримуємо результати від будь-якого воркера A
-        MPI_Status status;
-        int mapSizeReceived;
-
-        std::cout << "Master: Waiting for results #" << (i+1) << " of " << numUrls << std::endl;
-
-        MPI_Recv(&mapSizeReceived, 1, MPI_INT, MPI_ANY_SOURCE, URL_RESULT, MPI_COMM_WORLD, &status);
-
-        int workerA = status.MPI_SOURCE;
-        std::cout << "Master: Received map size from worker A " << workerA << ": " << mapSizeReceived << std::endl;
-
-        char* mapBuffer = new char[mapSizeReceived + 1];
-        MPI_Recv(mapBuffer, mapSizeReceived, MPI_CHAR, workerA, URL_RESULT, MPI_COMM_WORLD, &status);
-        mapBuffer[mapSizeReceived] = '\0';
-        std::string mapData(mapBuffer);
-        delete[] mapBuffer;
-
-        int contentSizeReceived;
-        MPI_Recv(&contentSizeReceived, 1, MPI_INT, workerA, CONTENT_RESULT, MPI_COMM_WORLD, &status);
-
-        std::cout << "Master: Received content size from worker A " << workerA << ": " << contentSizeReceived << std::endl;
-
-        char* contentBuffer = new char[contentSizeReceived + 1];
-        MPI_Recv(contentBuffer, contentSizeReceived, MPI_CHAR, workerA, CONTENT_RESULT, MPI_COMM_WORLD, &status);
-        contentBuffer[contentSizeReceived] = '\0';
-        std::string contentData(contentBuffer);
-        delete[] contentBuffer;
-
-        // Отримуємо URL, для якого воркер надіслав результати
-        int urlSizeReceived;
-        MPI_Recv(&urlSizeReceived, 1, MPI_INT, workerA, URL_RESULT, MPI_COMM_WORLD, &status);
-
-        char* urlBuffer = new char[urlSizeReceived + 1];
-        MPI_Recv(urlBuffer, urlSizeReceived, MPI_CHAR, workerA, URL_RESULT, MPI_COMM_WORLD, &status);
-        urlBuffer[urlSizeReceived] = '\0';
-        std::string crawledUrl(urlBuffer);
-        delete[] urlBuffer;
-
-        std::cout << "Master: Processed URL: " << crawledUrl << std::endl;
+    std::vector<char> batchBuffer;
+    std::vector<PageAnalysisResult> pages;
 
+    for (const auto& url : URLs) {
         // Створення каталогу для результатів цього URL
-        std::string safeUrlName = urlToSafeFilename(crawledUrl);
-        std::string resultDirName = getCurrentDateTime() + "_" + safeUrlName;
+        // stranky se zapisuji, jak prichazeji
+        std::string resultDirName = getCurrentDateTime() + "_" + urlToSafeFilename(url);
         std::string resultDir = "results/" + resultDirName;
         std::filesystem::create_directory(resultDir);
+        CResultWriter writer(resultDir);
 
-        // Запис файлів з результатами
-        std::ofstream mapFile(resultDir + "/map.txt");
-        mapFile << mapData;
-        mapFile.close();
+        std::cout << "Master: Sending shared URL to all workers A: " << url << std::endl;
+        int urlLength = url.length();
+        for (int workerA = 1; workerA <= numWorkerA; ++workerA) {
+            MPI_Send(&urlLength, 1, MPI_INT, workerA, URL_TASK, MPI_COMM_WORLD);
+            MPI_Send(url.c_str(), urlLength, MPI_CHAR, workerA, URL_TASK, MPI_COMM_WORLD);
+        }
 
-        std::ofstream contentFile(resultDir + "/content.txt");
-        contentFile << contentData;
-        contentFile.close();
+        // kazdy Worker A prubezne posila vysledky stranek, ktere vlastni; prazdna davka = jeho konec
+        std::vector<uint64_t> queueOfA(numWorkerA + 1, 0);
+        int finishedWorkersA = 0;
+        auto onMessage = [&](MPI_Status& probed) {
+            switch (probed.MPI_TAG) {
+                case PAGE_BATCH:
+                    if (!receivePageBatch(probed, writer, batchBuffer, pages)) {
+                        finishedWorkersA++;
+                    }
+                    break;
+                case QUEUE_STATUS: {
+                    queueOfA[probed.MPI_SOURCE] = receiveQueueStatus(probed);
+                    uint64_t queued = 0;
+                    for (uint64_t depth : queueOfA) {
+                        queued += depth;
+                    }
+                    CCrawlProgress::Instance().Set_Queue_Depth(queued);
+                    break;
+                }
+                default:
+                    std::cerr << "Master: Unexpected message tag " << probed.MPI_TAG << " from " << probed.MPI_SOURCE << std::endl;
+                    discardMessage(probed);
+                    break;
+            }
+        };
 
-        std::string endTime = getLogDateTime();
+        waitForDistributedTermination(numWorkerA, onMessage);
+        while (finishedWorkersA < numWorkerA) {
+            MPI_Status probed;
+            MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probed);
+            onMessage(probed);
+        }
 
-        std::ofstream logFile(resultDir + "/log.txt");
-        logFile << startTime << std::endl;
-        logFile << endTime << std::endl;
-        logFile << "OK" << std::endl;
-        logFile.close();
+        writer.Finish(startTime, getLogDateTime());
+        CCrawlProgress::Instance().Domain_Done();
+        std::cout << "Master: Wrote " << writer.Pages() << " pages for " << url << std::endl;
 
-        output += "<li>Оброблено URL: " + crawledUrl + " - результати збережено в " + resultDirName + "</li>";
+        output += "<li>Оброблено URL: " + url + " - результати збережено в " + resultDirName + "</li>";
     }
 
     output += "</ul>";
-    std::cout << "Master: All URLs processed successfully" << std::endl;
 }
 
+ // Майстер процес - розподіляє роботу і збирає результати
+void masterProcess(const std::vector<std::string>& URLs, int numWorkerA, int numWorkerB, std::string& output) {
+    int numUrls = URLs.size();
 
-// Worker A - керує групою Worker B і відповідає за одну домену
-void workerA(int myRank, int numWorkerB, int numWorkerA) {
-    int firstWorkerB = (numWorkerB * myRank) - numWorkerB + numWorkerA + 1;
-    std::vector<int> availableWorkersB;
-    int busyWorkersB = 0; // Лічильник занятих Worker B
+    // Worker B, ktere prave pouziva kazdy Worker A (index = rank Worker A); Worker A bez domeny je vraci mastrovi
+    std::vector<std::vector<int>> workersOfA(numWorkerA + 1);
+    std::vector<bool> activeA(numWorkerA + 1, false);
+    std::vector<int> freeWorkersB;
 
-    std::cout << "Worker A " << myRank << ": Starting with first Worker B = " << firstWorkerB << std::endl;
+    // ukonci Worker A a jeho Worker B vrati mezi volne
+    auto retireWorkerA = [&](int workerA) {
+        int terminate = -1;
+        std::cout << "Master: Sending termination signal to worker A " << workerA << std::endl;
+        MPI_Send(&terminate, 1, MPI_INT, workerA, URL_TASK, MPI_COMM_WORLD);
+
+        activeA[workerA] = false;
+        freeWorkersB.insert(freeWorkersB.end(), workersOfA[workerA].begin(), workersOfA[workerA].end());
+        workersOfA[workerA].clear();
+    };
+
+    // volne Worker B rozdeli po jednom tem aktivnim Worker A, ktere jich maji nejmene
+    auto lendFreeWorkersB = [&]() {
+        std::vector<std::vector<int>> grants(numWorkerA + 1);
+        while (!freeWorkersB.empty()) {
+            int target = -1;
+            for (int a = 1; a <= numWorkerA; a++) {
+                if (activeA[a] && (target == -1
+                    || workersOfA[a].size() + grants[a].size() < workersOfA[target].size() + grants[target].size())) {
+                    target = a;
+                }
+            }
+            if (target == -1) {
+                break;
+            }
+            grants[target].push_back(freeWorkersB.back());
+            freeWorkersB.pop_back();
+        }
 
-    // Ініціалізація списку доступних Worker B
-    for (int i = 0; i < numWorkerB; ++i) {
-        availableWorkersB.push_back(firstWorkerB + i);
-    }
+        for (int a = 1; a <= numWorkerA; a++) {
+            if (grants[a].empty()) {
+                continue;
+            }
+            std::cout << "Master: Lending " << grants[a].size() << " Worker B to worker A " << a << std::endl;
+            MPI_Send(grants[a].data(), static_cast<int>(grants[a].size()), MPI_INT, a, WORKER_GRANT, MPI_COMM_WORLD);
+            workersOfA[a].insert(workersOfA[a].end(), grants[a].begin(), grants[a].end());
+        }
+    };
 
-    while (true) {
-        MPI_Status status;
-        int urlLength;
+    // ukonci vsechny Worker B; prazdna uloha = konec, kazdy Worker B potvrdi zpravou TERMINATE
+    auto terminateWorkersB = [&]() {
+        int totalWorkersB = numWorkerA * numWorkerB;
+        for (int b = numWorkerA + 1; b <= numWorkerA + totalWorkersB; b++) {
+            MPI_Send(nullptr, 0, MPI_CHAR, b, URL_TASK, MPI_COMM_WORLD);
+        }
+        for (int i = 0; i < totalWorkersB; i++) {
+            int workerB;
+            MPI_Status status;
+            MPI_Recv(&workerB, 1, MPI_INT, MPI_ANY_SOURCE, TERMINATE, MPI_COMM_WORLD, &status);
+        }
+        std::cout << "Master: All Worker B processes finished" << std::endl;
+    };
 
-        std::cout << "Worker A " << myRank << ": Waiting for URL task" << std::endl;
-        MPI_Recv(&urlLength, 1, MPI_INT, 0, URL_TASK, MPI_COMM_WORLD, &status);
+    // Перевіряємо, чи є що розподіляти
+    if (numUrls == 0) {
+        output = "<h2>Немає URL для обробки</h2>";
 
-        // Перевірка на сигнал завершення
-        if (urlLength == -1) {
-            std::cout << "Worker A " << myRank << ": Received termination signal" << std::endl;
-            break;
+        // Повідомляємо всім воркерам A про завершення
+        for (int i = 1; i <= numWorkerA; ++i) {
+            retireWorkerA(i);
         }
+        terminateWorkersB();
+        return;
+    }
 
-        // Отримання URL
-        char* urlBuffer = new char[urlLength + 1];
-        MPI_Recv(urlBuffer, urlLength, MPI_CHAR, 0, URL_TASK, MPI_COMM_WORLD, &status);
-        urlBuffer[urlLength] = '\0';
-        std::string startUrl(urlBuffer);
-        delete[] urlBuffer;
+    std::string startTime = getLogDateTime();
+    std::cout << "Master: Starting processing " << numUrls << " URLs" << std::endl;
 
-        std::cout << "Worker A " << myRank << ": Processing URL: " << startUrl << std::endl;
+    if (mpiCrawlMode == MpiCrawlMode::SharedDomain) {
+        masterSharedDomains(URLs, numWorkerA, startTime, output);
+        for (int workerA = 1; workerA <= numWorkerA; ++workerA) {
+            retireWorkerA(workerA);
+        }
+        terminateWorkersB();
+        return;
+    }
 
-        // Структури даних для відстеження обходу
-        std::queue<std::string> urlQueue;
-        std::unordered_set<std::string> visitedUrls;
-        std::unordered_map<std::string, PageAnalysisResult> results;
-        std::string baseUrl = getBaseUrl(startUrl);
-
-        urlQueue.push(startUrl);
-        visitedUrls.insert(startUrl);
-
-        int processedUrls = 0;
-        int maxUrlsToProcess = 100; // Обмеження для уникнення нескінченного обходу
-
-        // Обробка всіх URL для цієї домени
-        while ((!urlQueue.empty() || busyWorkersB > 0) && processedUrls < maxUrlsToProcess) {
-            // Призначаємо роботу доступним Worker B, якщо є URL в черзі
-            while (!urlQueue.empty() && !availableWorkersB.empty() && processedUrls < maxUrlsToProcess) {
-                std::string currentUrl = urlQueue.front();
-                urlQueue.pop();
-
-                // Отримання доступного Worker B
-                int workerB = availableWorkersB.back();
-                availableWorkersB.pop_back();
-                busyWorkersB++; // Збільшуємо лічильник занятих Worker B
-
-                std::cout << "Worker A " << myRank << ": Assigning URL to Worker B " << workerB
-                          << ": " << currentUrl << " (busy workers: " << busyWorkersB << ")" << std::endl;
-
-                // Відправка URL до Worker B
-                int urlLength = currentUrl.length();
-                MPI_Send(&urlLength, 1, MPI_INT, workerB, URL_TASK, MPI_COMM_WORLD);
-                MPI_Send(currentUrl.c_str(), urlLength, MPI_CHAR, workerB, URL_TASK, MPI_COMM_WORLD);
-            }
+    // Створення каталогу для результатів
+    std::filesystem::create_directory("results");
 
-            // Очікуємо результат від Worker B, якщо є зайняті воркери
-            if (busyWorkersB > 0) {
-                // Отримання результату від Worker B і додавання його назад у список доступних
-                int workerB;
+    // domena, kterou prave obchazi kazdy Worker A, a prubezny zapis jejich vysledku (index = rank Worker A)
+    std::vector<std::string> urlOfA(numWorkerA + 1);
+    std::vector<std::string> resultDirOfA(numWorkerA + 1);
+    std::vector<std::unique_ptr<CResultWriter>> writerOfA(numWorkerA + 1);
+    std::vector<uint64_t> queueOfA(numWorkerA + 1, 0);
 
-                std::cout << "Worker A " << myRank << ": Waiting for any Worker B to finish (busy: "
-                          << busyWorkersB << ")" << std::endl;
-                MPI_Status b_status;
-                MPI_Recv(&workerB, 1, MPI_INT, MPI_ANY_SOURCE, TERMINATE, MPI_COMM_WORLD, &b_status);
+    // Відправка URL до воркера A
+    auto sendStartUrl = [&](int workerA, const std::string& url) {
+        int urlLength = url.length();
 
-                workerB = b_status.MPI_SOURCE; // використовуємо реальне джерело повідомлення
-                availableWorkersB.push_back(workerB);
-                busyWorkersB--; // Зменшуємо лічильник занятих Worker B
+        // Створення каталогу для результатів цього URL
+        // stranky se zapisuji, jak prichazeji
+        urlOfA[workerA] = url;
+        resultDirOfA[workerA] = getCurrentDateTime() + "_" + urlToSafeFilename(url);
+        std::string resultDir = "results/" + resultDirOfA[workerA];
+        std::filesystem::create_directory(resultDir);
+        writerOfA[workerA] = std::make_unique<CResultWriter>(resultDir);
 
-                std::cout << "Worker A " << myRank << ": Worker B " << workerB
-                          << " finished (remaining busy: " << busyWorkersB << ")" << std::endl;
+        std::cout << "Master: Sending URL to worker A " << workerA << ": " << url << std::endl;
 
-                // Отримання результатів аналізу
-                int urlLength;
-                MPI_Recv(&urlLength, 1, MPI_INT, workerB, URL_RESULT, MPI_COMM_WORLD, &b_status);
+        MPI_Send(&urlLength, 1, MPI_INT, workerA, URL_TASK, MPI_COMM_WORLD);
+        MPI_Send(url.c_str(), urlLength, MPI_CHAR, workerA, URL_TASK, MPI_COMM_WORLD);
+        activeA[workerA] = true;
+    };
 
-                char* urlBuffer = new char[urlLength + 1];
-                MPI_Recv(urlBuffer, urlLength, MPI_CHAR, workerB, URL_RESULT, MPI_COMM_WORLD, &b_status);
-                urlBuffer[urlLength] = '\0';
-                std::string analyzedUrl(urlBuffer);
-                delete[] urlBuffer;
+    // Розподіл URL між воркерами A
+    // kazdy dostane jednu domenu, dalsi az po odevzdani vysledku
+    size_t nextUrl = 0;
+    for (int workerA = 1; workerA <= numWorkerA; ++workerA) {
+        workersOfA[workerA] = initialWorkersB(workerA, numWorkerA, numWorkerB);
+        if (nextUrl < URLs.size()) {
+            sendStartUrl(workerA, URLs[nextUrl++]);
+        } else {
+            // domen je mene nez Worker A - jeho Worker B pomohou ostatnim
+            retireWorkerA(workerA);
+        }
+    }
+    lendFreeWorkersB();
 
-                std::cout << "Worker A " << myRank << ": Received analysis for URL: " << analyzedUrl << std::endl;
+    // Отримання результатів від воркерів A
+    // davky stranek prubezne, prazdna davka = domena hotova
+    output = "<h2>Результати краулінгу</h2><ul>";
 
-                // Отримання кількості зображень, посилань, форм
-                int imageCount, linkCount, formCount, headersCount;
-                MPI_Recv(&imageCount, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
-                MPI_Recv(&linkCount, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
-                MPI_Recv(&formCount, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
-                MPI_Recv(&headersCount, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
+    std::vector<char> batchBuffer;
+    std::vector<PageAnalysisResult> pages;
+    int finishedUrls = 0;
 
-                // Отримання заголовків
-                PageAnalysisResult result;
-                result.url = analyzedUrl;
-                result.imageCount = imageCount;
-                result.linkCount = linkCount;
-                result.formCount = formCount;
+    while (finishedUrls < numUrls) {
+        MPI_Status status;
+        MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        int workerA = status.MPI_SOURCE;
 
-                for (int i = 0; i < headersCount; i++) {
-                    int level;
-                    MPI_Recv(&level, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
+        if (status.MPI_TAG == QUEUE_STATUS) {
+            queueOfA[workerA] = receiveQueueStatus(status);
+            uint64_t queued = 0;
+            for (uint64_t depth : queueOfA) {
+                queued += depth;
+            }
+            CCrawlProgress::Instance().Set_Queue_Depth(queued);
+            continue;
+        }
+        if (status.MPI_TAG != PAGE_BATCH || !writerOfA[workerA]) {
+            std::cerr << "Master: Unexpected message tag " << status.MPI_TAG << " from " << workerA << std::endl;
+            discardMessage(status);
+            continue;
+        }
+        if (receivePageBatch(status, *writerOfA[workerA], batchBuffer, pages)) {
+            continue;
+        }
 
-                    int textLength;
-                    MPI_Recv(&textLength, 1, MPI_INT, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
+        finishedUrls++;
+        writerOfA[workerA]->Finish(startTime, getLogDateTime());
+        CCrawlProgress::Instance().Domain_Done();
+        std::cout << "Master: Processed URL: " << urlOfA[workerA] << " (" << writerOfA[workerA]->Pages() << " pages, "
+                  << finishedUrls << " of " << numUrls << ")" << std::endl;
+        writerOfA[workerA].reset();
+
+        output += "<li>Оброблено URL: " + urlOfA[workerA] + " - результати збережено в " + resultDirOfA[workerA] + "</li>";
+
+        // Worker A je volny - dalsi domena z fronty, jinak jeho Worker B pujcime ostatnim
+        if (nextUrl < URLs.size()) {
+            sendStartUrl(workerA, URLs[nextUrl++]);
+        } else {
+            retireWorkerA(workerA);
+            lendFreeWorkersB();
+        }
+    }
 
-                    char* textBuffer = new char[textLength + 1];
-                    MPI_Recv(textBuffer, textLength, MPI_CHAR, workerB, CONTENT_RESULT, MPI_COMM_WORLD, &b_status);
-                    textBuffer[textLength] = '\0';
+    terminateWorkersB();
 
-                    result.headers.push_back({level, std::string(textBuffer)});
-                    delete[] textBuffer;
-                }
+    output += "</ul>";
+    std::cout << "Master: All URLs processed successfully" << std::endl;
+}
 
-                // Отримання знайдених URL
-                int urlsCount;
-                MPI_Recv(&urlsCount, 1, MPI_INT, workerB, URL_RESULT, MPI_COMM_WORLD, &b_status);
 
-                std::cout << "Worker A " << myRank << ": URL " << analyzedUrl << " has " << urlsCount << " links" << std::endl;
+// Worker A - obchod jedne domeny vlastni skupinou Worker B (rezim DomainPerWorkerA)
+void crawlDomain(int myRank, const std::string& startUrl, CWorkerBGroup& workersB) {
+    // Структури даних для відстеження обходу - черга разом з множиною відвіданих URL (див. visitedSetMode)
+    CCrawlFrontier frontier(visitedSetMode);
+    // vysledky odchazi mastrovi prubezne, Worker A je neuklada
+    CPageBatchSender reporter(PageBatchBytes, ReportBatchPages, ReportInterval);
+    CDuplicateIndex duplicates;
+    std::string baseUrl = getBaseUrl(startUrl);
+
+    // Worker B jsou samostatne procesy a o sobe nevi - zatez hostitele ridi Worker A pri prirazovani URL
+    CHostScheduler scheduler;
+    std::string origin = getOrigin(startUrl);
+    if (scheduleHosts()) {
+        scheduler.Set_Robots_Loader(loadRobots);
+        scheduler.Prepare(origin);
+    }
 
-                for (int i = 0; i < urlsCount; i++) {
-                    int foundUrlLength;
-                    MPI_Recv(&foundUrlLength, 1, MPI_INT, workerB, URL_RESULT, MPI_COMM_WORLD, &b_status);
+    frontier.Push_If_New(startUrl);
+
+    int processedUrls = 0;
+    int maxUrlsToProcess = 100; // Обмеження для уникнення нескінченного обходу
+
+    // Обробка всіх URL для цієї домени
+    while ((!frontier.Empty() || workersB.In_Flight() > 0) && processedUrls < maxUrlsToProcess) {
+        // Prirazujeme praci Worker B, dokud kazdy nema PrefetchDepth URL dopredu;
+        // rozpracovane URL se pocitaji do limitu, aby se nestahovaly stranky, ktere se pak zahodi.
+        // Dalsi URL jde Worker B, jen kdyz ji hostitel snese (CHostScheduler)
+        CHostScheduler::Clock::duration hostWait = CHostScheduler::Clock::duration::max();
+        while (!frontier.Empty() && processedUrls + workersB.In_Flight() < maxUrlsToProcess && workersB.Can_Assign()
+               && acquireHost(scheduler, origin, hostWait)) {
+            std::string currentUrl = frontier.Pop();
+            if (currentUrl.length() > static_cast<size_t>(MaxTaskUrlLength)) {
+                std::cerr << "Worker A " << myRank << ": Skipping URL longer than " << MaxTaskUrlLength << " bytes" << std::endl;
+                if (scheduleHosts()) {
+                    scheduler.Cancel(origin);
+                }
+                continue;
+            }
 
-                    char* foundUrlBuffer = new char[foundUrlLength + 1];
-                    MPI_Recv(foundUrlBuffer, foundUrlLength, MPI_CHAR, workerB, URL_RESULT, MPI_COMM_WORLD, &b_status);
-                    foundUrlBuffer[foundUrlLength] = '\0';
-                    std::string foundUrl(foundUrlBuffer);
-                    delete[] foundUrlBuffer;
+            std::cout << "Worker A " << myRank << ": Assigning URL: " << currentUrl << std::endl;
+            int workerB = workersB.Assign(std::move(currentUrl));
+            std::cout << "Worker A " << myRank << ": Assigned to Worker B " << workerB
+                      << " (in flight: " << workersB.In_Flight() << ")" << std::endl;
+        }
 
-                    result.foundUrls.push_back(foundUrl);
+        // Cekame na vysledek od Worker B, pokud jsou odeslane URL (nebo az master pujci prvni Worker B)
+        if (workersB.In_Flight() > 0 || workersB.Size() == 0) {
+            std::cout << "Worker A " << myRank << ": Waiting for any Worker B to finish (in flight: "
+                      << workersB.In_Flight() << ")" << std::endl;
+
+            // Cely vysledek prijde v jedne zprave; velikost zjistime predem z MPI_Probe.
+            // Behem obchodu domeny posila tomuto Worker A zpravy jen master (WORKER_GRANT) a Worker B (PAGE_RESULT).
+            // Ceka se jen do chvile, kdy hostitel snese dalsi URL
+            MPI_Status probed;
+            if (!probeMessage(probed, hostWait)) {
+                continue;
+            }
+            if (probed.MPI_TAG == WORKER_GRANT) {
+                workersB.Receive_Grant(probed);
+                std::cout << "Worker A " << myRank << ": Borrowed Worker B (now " << workersB.Size() << ")" << std::endl;
+                continue;
+            }
 
-                    // Додавання нових URL в чергу
-                    if (visitedUrls.find(foundUrl) == visitedUrls.end() && isSameDomain(baseUrl, foundUrl)) {
-                        urlQueue.push(foundUrl);
-                        visitedUrls.insert(foundUrl);
-                    }
+            int workerB = probed.MPI_SOURCE; // використовуємо реальне джерело повідомлення
+            PageAnalysisResult result;
+            if (!workersB.Receive_Result(probed, result)) {
+                std::cerr << "Worker A " << myRank << ": Malformed result from Worker B " << workerB << std::endl;
+                if (scheduleHosts()) {
+                    scheduler.Cancel(origin);
                 }
-
-                results[analyzedUrl] = result;
-                processedUrls++;
-            } else if (urlQueue.empty()) {
-                // Якщо немає більше URL в черзі і немає занятих Worker B, виходимо з циклу
-                break;
+                continue;
             }
-        }
+            releaseHost(scheduler, origin, result);
 
-        // Повідомлення про завершення для всіх воркерів B
-        std::cout << "Worker A " << myRank << ": Sending termination to all Worker B processes" << std::endl;
-        for (int i = 0; i < numWorkerB; i++) {
-            int currentWorkerB = firstWorkerB + i;
-            int terminate = -1;
-            MPI_Send(&terminate, 1, MPI_INT, currentWorkerB, URL_TASK, MPI_COMM_WORLD);
-        }
+            std::cout << "Worker A " << myRank << ": Worker B " << workerB << " finished (remaining in flight: "
+                      << workersB.In_Flight() << "), analysis for URL: " << result.url
+                      << " (" << result.foundUrls.size() << " links)" << std::endl;
 
-        // Очікування завершення всіх Worker B
-        while (availableWorkersB.size() < numWorkerB) {
-            int workerB;
-            MPI_Status b_status;
-            MPI_Recv(&workerB, 1, MPI_INT, MPI_ANY_SOURCE, TERMINATE, MPI_COMM_WORLD, &b_status);
-
-            workerB = b_status.MPI_SOURCE;
-            bool alreadyAvailable = false;
-            for (int wb : availableWorkersB) {
-                if (wb == workerB) {
-                    alreadyAvailable = true;
-                    break;
+            // duplicita jde mastrovi jako alias bez odkazu, takze se z ni nic neprida
+            skipDuplicate(duplicates, result, [&](const std::string& url) { return isSameDomain(baseUrl, url) && !frontier.Contains(url); });
+
+            // Додавання нових URL в чергу
+            for (const std::string& foundUrl : result.foundUrls) {
+                if (isSameDomain(baseUrl, foundUrl)) {
+                    frontier.Push_If_New(foundUrl);
                 }
             }
 
-            if (!alreadyAvailable) {
-                availableWorkersB.push_back(workerB);
-                std::cout << "Worker A " << myRank << ": Worker B " << workerB << " finished (final)" << std::endl;
-            }
+            reporter.Add(result, frontier.Queued());
+            processedUrls++;
+        } else if (frontier.Empty()) {
+            // Якщо немає більше URL в черзі і немає відправлених URL, виходимо з циклу
+            break;
+        } else {
+            // nic nebezi a hostitel zatim dalsi pozadavek nesnese (token bucket, Retry-After)
+            std::this_thread::sleep_for(hostWait == CHostScheduler::Clock::duration::max() ? std::chrono::milliseconds(1) : hostWait);
         }
+    }
 
-        // Підготовка результатів для відправки назад майстру
-        std::stringstream mapSs, contentSs;
+    std::cout << "Worker A " << myRank << ": ";
+    frontier.Print_Stats(std::cout);
+    std::cout << "Worker A " << myRank << ": ";
+    printDuplicateStats(std::cout, duplicates);
+    std::cout << "Worker A " << myRank << ": ";
+    scheduler.Print_Stats(std::cout);
 
-        // Обмеження кількості URL для майстра (якщо їх забагато)
-        int maxUrlsToReport = 1000;
-        std::vector<std::string> urlsToReport;
+    // Vysledky, ktere jeste nedorazily (napr. po chybne zprave), uz se nezapocitaji -
+    // musime je ale prijmout, aby nezustaly ve fronte zprav pro dalsi domenu
+    workersB.Drain();
 
-        for (const auto& pair : results) {
-            if (urlsToReport.size() < maxUrlsToReport) {
-                urlsToReport.push_back(pair.first);
+    // zbytek vysledku a prazdna davka = domena hotova
+    reporter.Finish();
+    std::cout << "Worker A " << myRank << ": Reported " << reporter.Pages_Sent() << " pages to master" << std::endl;
+}
+
+// Worker A - podil na spolecnem obchodu jedne domeny (rezim SharedDomain).
+// Worker A obchazi jen URL, ktere mu patri podle hashe; ostatni nalezene URL posila v davkach jejich vlastnikum.
+// Vysledky stranek posila mastrovi prubezne; konec domeny urci master (waitForDistributedTermination).
+void crawlSharedDomain(int myRank, int numWorkerA, const std::string& startUrl, CWorkerBGroup& workersB) {
+    CDistributedFrontier frontier(myRank, numWorkerA, visitedSetMode, UrlBatchSize);
+    CPageBatchSender reporter(PageBatchBytes, ReportBatchPages, ReportInterval);
+    // jen stranky tohoto Worker A - kopie pod URL jineho vlastnika se nepoznaji
+    CDuplicateIndex duplicates;
+    std::string baseUrl = getBaseUrl(startUrl);
+
+    // hostitel sdileji vsichni Worker A domeny - kazdy ma jen svuj podil na limitech
+    CHostScheduler scheduler(1.0 / numWorkerA);
+    std::string origin = getOrigin(startUrl);
+    if (scheduleHosts()) {
+        scheduler.Set_Robots_Loader(loadRobots);
+        scheduler.Prepare(origin);
+    }
+
+    if (frontier.Owner(startUrl) == myRank) {
+        frontier.Add(startUrl);
+    }
+
+    int processedUrls = 0;
+    bool probePending = false; // master ceka na citace, odpovime az budeme necinni
+    bool finished = false;
+
+    while (!finished) {
+        CHostScheduler::Clock::duration hostWait = CHostScheduler::Clock::duration::max();
+        while (!frontier.Empty() && processedUrls + workersB.In_Flight() < SharedDomainMaxUrlsPerWorkerA && workersB.Can_Assign()
+               && acquireHost(scheduler, origin, hostWait)) {
+            std::string currentUrl = frontier.Pop();
+            if (currentUrl.length() > static_cast<size_t>(MaxTaskUrlLength)) {
+                std::cerr << "Worker A " << myRank << ": Skipping URL longer than " << MaxTaskUrlLength << " bytes" << std::endl;
+                if (scheduleHosts()) {
+                    scheduler.Cancel(origin);
+                }
+                continue;
             }
+            workersB.Assign(std::move(currentUrl));
         }
 
-        // Запис вузлів графа
-        for (const auto& url : urlsToReport) {
-            mapSs << url << std::endl;
+        // nalezene URL jinych Worker A odejdou pred cekanim, aby na ne vlastnici necekali
+        frontier.Flush();
+
+        bool idle = workersB.In_Flight() == 0 && (frontier.Empty() || processedUrls >= SharedDomainMaxUrlsPerWorkerA);
+        if (idle && probePending) {
+            reportTerminationCounters(frontier);
+            probePending = false;
         }
 
-        // Запис ребер графа
-        for (const auto& url : urlsToReport) {
-            const auto& result = results[url];
-            for (const std::string& targetUrl : result.foundUrls) {
-                if (results.find(targetUrl) != results.end()) {
-                    mapSs << url << " " << targetUrl << std::endl;
-                }
-            }
+        // zpravy od Worker B (PAGE_RESULT), ostatnich Worker A (URL_BATCH) a mastra (TERMINATION_PROBE, WORKER_GRANT);
+        // ceka se jen do chvile, kdy hostitel snese dalsi URL
+        MPI_Status probed;
+        if (!probeMessage(probed, hostWait)) {
+            continue;
         }
 
-        // Запис даних про контент
-        for (const auto& url : urlsToReport) {
-            const auto& result = results[url];
-            contentSs << url << std::endl;
-            contentSs << "IMAGES " << result.imageCount << std::endl;
-            contentSs << "LINKS " << result.linkCount << std::endl;
-            contentSs << "FORMS " << result.formCount << std::endl;
-
-            for (const auto& header : result.headers) {
-                for (int i = 0; i < header.first; i++) {
-                    contentSs << "-";
+        switch (probed.MPI_TAG) {
+            case PAGE_RESULT: {
+                PageAnalysisResult result;
+                if (!workersB.Receive_Result(probed, result)) {
+                    std::cerr << "Worker A " << myRank << ": Malformed result from Worker B " << probed.MPI_SOURCE << std::endl;
+                    if (scheduleHosts()) {
+                        scheduler.Cancel(origin);
+                    }
+                    break;
                 }
-                contentSs << " " << header.second << std::endl;
+                releaseHost(scheduler, origin, result);
+                // usetrena stazeni se odhadnou jen z URL tohoto Worker A
+                skipDuplicate(duplicates, result, [&](const std::string& url) {
+                    return isSameDomain(baseUrl, url) && frontier.Owner(url) == myRank && !frontier.Contains(url);
+                });
+                for (const std::string& foundUrl : result.foundUrls) {
+                    if (isSameDomain(baseUrl, foundUrl)) {
+                        frontier.Add(foundUrl);
+                    }
+                }
+                reporter.Add(result, frontier.Queued());
+                processedUrls++;
+                break;
+            }
+            case URL_BATCH:
+                frontier.Receive_Batch(probed);
+                break;
+            case TERMINATION_PROBE: {
+                int wave;
+                MPI_Recv(&wave, 1, MPI_INT, 0, TERMINATION_PROBE, MPI_COMM_WORLD, &probed);
+                if (wave == -1) {
+                    finished = true;
+                } else {
+                    probePending = true;
+                }
+                break;
             }
-            contentSs << std::endl;
+            case WORKER_GRANT:
+                workersB.Receive_Grant(probed);
+                break;
+            default:
+                std::cerr << "Worker A " << myRank << ": Unexpected message tag " << probed.MPI_TAG << std::endl;
+                discardMessage(probed);
+                break;
         }
+    }
 
-        // Відправка результатів до майстра
-        std::string mapData = mapSs.str();
-        int mapSize = mapData.length();
+    frontier.Wait_Sends();
+    std::cout << "Worker A " << myRank << ": Crawled " << processedUrls << " pages. ";
+    frontier.Print_Stats(std::cout);
+    std::cout << "Worker A " << myRank << ": ";
+    printDuplicateStats(std::cout, duplicates);
+    std::cout << "Worker A " << myRank << ": ";
+    scheduler.Print_Stats(std::cout);
 
-        std::cout << "Worker A " << myRank << ": Sending map data to master (" << mapSize << " bytes)" << std::endl;
+    // zbytek vysledku a prazdna davka = konec tohoto Worker A
+    reporter.Finish();
+}
 
-        MPI_Send(&mapSize, 1, MPI_INT, 0, URL_RESULT, MPI_COMM_WORLD);
-        MPI_Send(mapData.c_str(), mapSize, MPI_CHAR, 0, URL_RESULT, MPI_COMM_WORLD);
+// Worker A - керує групою Worker B і відповідає за одну домену
+void workerA(int myRank, int numWorkerB, int numWorkerA) {
+    // Worker B, kterym tento Worker A posila ulohy - zacina vlastni skupinou, master muze pujcit dalsi (WORKER_GRANT)
+    CWorkerBGroup workersB(initialWorkersB(myRank, numWorkerA, numWorkerB), PrefetchDepth);
 
-        std::string contentData = contentSs.str();
-        int contentSize = contentData.length();
+    std::cout << "Worker A " << myRank << ": Starting with " << workersB.Size() << " Worker B"
+              << ", prefetch depth " << PrefetchDepth << std::endl;
 
-        std::cout << "Worker A " << myRank << ": Sending content data to master (" << contentSize << " bytes)" << std::endl;
+    while (true) {
+        MPI_Status status;
+        int urlLength;
 
-        MPI_Send(&contentSize, 1, MPI_INT, 0, CONTENT_RESULT, MPI_COMM_WORLD);
-        MPI_Send(contentData.c_str(), contentSize, MPI_CHAR, 0, CONTENT_RESULT, MPI_COMM_WORLD);
+        // mezi domenami muze master jeste pujcit Worker B
+        std::cout << "Worker A " << myRank << ": Waiting for URL task" << std::endl;
+        MPI_Probe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (status.MPI_TAG == WORKER_GRANT) {
+            workersB.Receive_Grant(status);
+            std::cout << "Worker A " << myRank << ": Borrowed Worker B (now " << workersB.Size() << ")" << std::endl;
+            continue;
+        }
+        MPI_Recv(&urlLength, 1, MPI_INT, 0, URL_TASK, MPI_COMM_WORLD, &status);
 
-        // Відправка оригінального URL
-        int urlSize = startUrl.length();
+        // Перевірка на сигнал завершення
+        if (urlLength == -1) {
+            std::cout << "Worker A " << myRank << ": Received termination signal" << std::endl;
+            break;
+        }
 
-        std::cout << "Worker A " << myRank << ": Sending original URL to master: " << startUrl << std::endl;
+        // Отримання URL
+        char* urlBuffer = new char[urlLength + 1];
+        MPI_Recv(urlBuffer, urlLength, MPI_CHAR, 0, URL_TASK, MPI_COMM_WORLD, &status);
+        urlBuffer[urlLength] = '\0';
+        std::string startUrl(urlBuffer);
+        delete[] urlBuffer;
 
-        MPI_Send(&urlSize, 1, MPI_INT, 0, URL_RESULT, MPI_COMM_WORLD);
-        MPI_Send(startUrl.c_str(), urlSize, MPI_CHAR, 0, URL_RESULT, MPI_COMM_WORLD);
+        std::cout << "Worker A " << myRank << ": Processing URL: " << startUrl << std::endl;
+
+        if (mpiCrawlMode == MpiCrawlMode::SharedDomain) {
+            crawlSharedDomain(myRank, numWorkerA, startUrl, workersB);
+        } else {
+            crawlDomain(myRank, startUrl, workersB);
+        }
     }
 
+    // Worker B ukoncuje master - po skonceni teto domeny je mohl pujcit jinemu Worker A
+    std::cout << "Worker A " << myRank << ": Message buffers allocated: " << workersB.Buffer_Allocations() << std::endl;
     std::cout << "Worker A " << myRank << ": Exiting" << std::endl;
 }
 
-void workerB(int myRank, int masterA) {
-    std::cout << "Worker B " << myRank << ": Starting with master A = " << masterA << std::endl;
+void workerB(int myRank) {
+    std::cout << "Worker B " << myRank << ": Starting" << std::endl;
+
+    // dalsi uloha se prijima na pozadi (MPI_Irecv), zatimco se stahuje aktualni stranka.
+    // Ulohu muze poslat kterykoli Worker A (master pujcuje Worker B mezi skupinami), vysledek jde odesilateli ulohy;
+    // prazdnou ulohu = konec posila master.
+    std::vector<char> taskBuffer(MaxTaskUrlLength);
+    MPI_Request taskRequest;
+    MPI_Irecv(taskBuffer.data(), MaxTaskUrlLength, MPI_CHAR, MPI_ANY_SOURCE, URL_TASK, MPI_COMM_WORLD, &taskRequest);
+
+    // dva buffery pro vysledky - jeden se muze odesilat (MPI_Isend), zatimco se do druheho koduje dalsi stranka
+    std::vector<char> messages[2];
+    MPI_Request resultRequests[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+    int resultSlot = 0;
+
+    // dalsi uloha uz dorazila behem stahovani aktualni (MPI_Test) - jeji host se mezitim preklada
+    bool taskReady = false;
+    MPI_Status readyStatus;
+
+    // doba cekani na dalsi ulohu po dokonceni stranky
+    std::chrono::steady_clock::duration idleTime{};
+    int processedPages = 0;
 
     while (true) {
         MPI_Status status;
-        int urlLength;
 
         std::cout << "Worker B " << myRank << ": Waiting for URL task" << std::endl;
-        MPI_Recv(&urlLength, 1, MPI_INT, masterA, URL_TASK, MPI_COMM_WORLD, &status);
+        auto waitStart = std::chrono::steady_clock::now();
+        if (taskReady) {
+            // dokonceny pozadavek uz MPI_Test uvolnil, MPI_Wait by vratil prazdny status
+            status = readyStatus;
+            taskReady = false;
+        } else {
+            MPI_Wait(&taskRequest, &status);
+        }
 
-        // Перевірка на сигнал завершення
-        if (urlLength == -1) {
+        int urlLength;
+        MPI_Get_count(&status, MPI_CHAR, &urlLength);
+
+        // Перевірка на сигнал завершення (порожнє завдання)
+        if (urlLength == 0) {
             std::cout << "Worker B " << myRank << ": Received termination signal" << std::endl;
             break;
         }
 
-        // Отримання URL
-        char* urlBuffer = new char[urlLength + 1];
-        MPI_Recv(urlBuffer, urlLength, MPI_CHAR, masterA, URL_TASK, MPI_COMM_WORLD, &status);
-        urlBuffer[urlLength] = '\0';
-        std::string url(urlBuffer);
-        delete[] urlBuffer;
+        if (processedPages > 0) {
+            idleTime += std::chrono::steady_clock::now() - waitStart;
+        }
+
+        std::string url(taskBuffer.data(), urlLength);
+        int workerA = status.MPI_SOURCE;
+
+        // buffer je zkopirovany - muzeme hned prijimat dalsi ulohu
+        MPI_Irecv(taskBuffer.data(), MaxTaskUrlLength, MPI_CHAR, MPI_ANY_SOURCE, URL_TASK, MPI_COMM_WORLD, &taskRequest);
+
+        // Worker A posila PrefetchDepth uloh dopredu - pokud dalsi uz je tady, jeji host se prelozi soubezne se stahovanim
+        // (hodi se hlavne po zapujceni Worker B jine skupine, jinak je host obvykle stejny a uz v DNS cache)
+        int nextReady = 0;
+        MPI_Test(&taskRequest, &nextReady, &readyStatus);
+        if (nextReady) {
+            taskReady = true;
+            int nextLength;
+            MPI_Get_count(&readyStatus, MPI_CHAR, &nextLength);
+            if (nextLength > 0) {
+                prefetchHost(std::string(taskBuffer.data(), nextLength));
+            }
+        }
 
         std::cout << "Worker B " << myRank << ": Processing URL: " << url << std::endl;
 
         // Завантаження і аналіз HTML
-        std::string html;
-        html = utils::downloadHTML(url);
-        std::cout << "Worker B " << myRank << ": Downloaded HTML of size: " << html.length() << std::endl;
+        FetchedPage page = fetchPage(url);
+        std::cout << "Worker B " << myRank << ": Downloaded HTML of size: " << page.html.length() << std::endl;
 
         PageAnalysisResult result;
-        result = analyzeHtml(url, html);
+        result = analyzePage(url, page);
         std::cout << "Worker B " << myRank << ": Analyzed HTML, found " << result.foundUrls.size() << " URLs" << std::endl;
         // Захист від завеликих даних
         const int MAX_URLS = 100;
@@ -849,45 +1499,32 @@ void workerB(int myRank, int masterA) {
         }
 
         // Відправка результатів назад до Worker A
-        std::cout << "Worker B " << myRank << ": Sending results back to Worker A " << masterA << std::endl;
-        MPI_Send(&myRank, 1, MPI_INT, masterA, TERMINATE, MPI_COMM_WORLD);
-
-        // Відправка URL
-        urlLength = result.url.length();
-        MPI_Send(&urlLength, 1, MPI_INT, masterA, URL_RESULT, MPI_COMM_WORLD);
-        MPI_Send(result.url.c_str(), urlLength, MPI_CHAR, masterA, URL_RESULT, MPI_COMM_WORLD);
-
-        // Відправка інформації про контент
-        MPI_Send(&result.imageCount, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-        MPI_Send(&result.linkCount, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-        MPI_Send(&result.formCount, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-
-        // Відправка заголовків
-        int headersCount = result.headers.size();
-        MPI_Send(&headersCount, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-
-        for (const auto& header : result.headers) {
-            MPI_Send(&header.first, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
+        // jedna zprava, Worker A si velikost zjisti pres MPI_Probe; buffer se muze prepsat, az skonci jeho predchozi odesilani
+        MPI_Wait(&resultRequests[resultSlot], MPI_STATUS_IGNORE);
+        std::vector<char>& message = messages[resultSlot];
+        encodePage(result, message);
+        std::cout << "Worker B " << myRank << ": Sending results back to Worker A " << workerA
+                  << " (" << message.size() << " bytes)" << std::endl;
+        MPI_Isend(message.data(), static_cast<int>(message.size()), MPI_CHAR, workerA, PAGE_RESULT, MPI_COMM_WORLD, &resultRequests[resultSlot]);
+        resultSlot ^= 1;
+        processedPages++;
+    }
 
-            int textLength = header.second.length();
-            MPI_Send(&textLength, 1, MPI_INT, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-            MPI_Send(header.second.c_str(), textLength, MPI_CHAR, masterA, CONTENT_RESULT, MPI_COMM_WORLD);
-        }
+    MPI_Waitall(2, resultRequests, MPI_STATUSES_IGNORE);
 
-        // Відправка знайдених URL
-        int urlsCount = result.foundUrls.size();
-        MPI_Send(&urlsCount, 1, MPI_INT, masterA, URL_RESULT, MPI_COMM_WORLD);
+    std::cout << "Worker B " << myRank << ": Processed " << processedPages << " pages, waited "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(idleTime).count() << " ms for tasks" << std::endl;
 
-        for (const std::string& foundUrl : result.foundUrls) {
-            int foundUrlLength = foundUrl.length();
-            MPI_Send(&foundUrlLength, 1, MPI_INT, masterA, URL_RESULT, MPI_COMM_WORLD);
-            MPI_Send(foundUrl.c_str(), foundUrlLength, MPI_CHAR, masterA, URL_RESULT, MPI_COMM_WORLD);
-        }
-    }
+    // Повідомляємо майстру, що ми завершили роботу
+    CConnectionPool::Stats poolStats = CConnectionPool::Instance().Get_Stats();
+    std::cout << "Worker B " << myRank << ": Connection pool hits " << poolStats.hits << ", misses " << poolStats.misses
+              << ", evictions " << poolStats.evictions << std::endl;
+    CDnsCache::Stats dnsStats = CDnsCache::Instance().Get_Stats();
+    std::cout << "Worker B " << myRank << ": DNS cache hits " << dnsStats.hits << " (prefetched " << dnsStats.prefetchHits
+              << "), misses " << dnsStats.misses << ", failures " << dnsStats.failures << std::endl;
 
-    // Повідомляємо Worker A, що ми завершили роботу
-    std::cout << "Worker B " << myRank << ": Sending final termination to Worker A " << masterA << std::endl;
-    MPI_Send(&myRank, 1, MPI_INT, masterA, TERMINATE, MPI_COMM_WORLD);
+    std::cout << "Worker B " << myRank << ": Sending final termination to master" << std::endl;
+    MPI_Send(&myRank, 1, MPI_INT, 0, TERMINATE, MPI_COMM_WORLD);
     std::cout << "Worker B " << myRank << ": Exiting" << std::endl;
 }
 
@@ -928,8 +1565,7 @@ void processParallel(const std::vector<std::string>& URLs, std::string& vystup)
          vystup = ""; // Worker процеси не повертають HTML
      } else {
          // Worker B процес
-         int workerAId = ((rank - numWorkerA - 1) / numWorkerB) + 1;
-         workerB(rank, workerAId);
+         workerB(rank);
          vystup = ""; // Worker процеси не повертають HTML
      }
  }
@@ -0,0 +1,74 @@
+/**
+ * Soubor namapovany do pameti jen pro cteni
+ */
+
+#include "mapped_file.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CMappedFile::~CMappedFile() {
+	Close();
+}
+
+void CMappedFile::Close() {
+#ifndef _WIN32
+	if (m_mapped) {
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+#endif
+	m_mapped = false;
+	m_buffer.clear();
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool CMappedFile::Open(const std::string& path, std::string& error) {
+	Close();
+
+#ifndef _WIN32
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		error = "Nelze otevrit soubor: " + path;
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		::close(fd);
+		error = "Nelze zjistit velikost souboru: " + path;
+		return false;
+	}
+	// prazdny soubor nelze namapovat - je to ale platny soubor bez dat
+	if (st.st_size == 0) {
+		::close(fd);
+		return true;
+	}
+	void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) {
+		error = "Nelze namapovat soubor: " + path;
+		return false;
+	}
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<size_t>(st.st_size);
+	m_mapped = true;
+#else
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	if (!in) {
+		error = "Nelze otevrit soubor: " + path;
+		return false;
+	}
+	m_buffer.resize(static_cast<size_t>(in.tellg()));
+	in.seekg(0);
+	in.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+#endif
+	return true;
+}
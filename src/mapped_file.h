@@ -0,0 +1,32 @@
+/**
+ * Soubor namapovany do pameti jen pro cteni (POSIX mmap); na Windows se soubor nacte cely do pameti
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class CMappedFile {
+	private:
+		const char* m_data{ nullptr };
+		size_t m_size{ 0 };
+		// bez mmap (Windows) se soubor nacte cely do pameti
+		std::vector<char> m_buffer;
+		bool m_mapped{ false };
+
+	public:
+		CMappedFile() = default;
+		~CMappedFile();
+
+		CMappedFile(const CMappedFile&) = delete;
+		CMappedFile& operator=(const CMappedFile&) = delete;
+
+		// namapuje soubor; pri chybe vrati false a popis v error
+		bool Open(const std::string& path, std::string& error);
+		void Close();
+
+		const char* Data() const { return m_data; }
+		size_t Size() const { return m_size; }
+};
@@ -0,0 +1,17 @@
+/**
+ * Znacky MPI zprav mezi mastrem, Worker A a Worker B
+ */
+
+#pragma once
+
+enum MpiTags {
+    URL_TASK,
+    TERMINATE,
+    PAGE_RESULT,        // cely PageAnalysisResult v jedne zprave (viz page_message.h)
+    WORKER_GRANT,       // master -> Worker A: seznam ranku Worker B, ktere muze od ted pouzivat
+    URL_BATCH,          // Worker A -> Worker A: davka URL, ktere patri prijemci (rozdelena fronta, viz distributed_frontier.h)
+    TERMINATION_PROBE,  // master -> Worker A: dotaz na citace davek URL; cislo vlny -1 = konec domeny
+    TERMINATION_REPORT, // Worker A -> master: pocet odeslanych a prijatych davek URL
+    PAGE_BATCH,         // Worker A -> master: prubezna davka vysledku stranek; prazdna davka = konec domeny
+    QUEUE_STATUS        // Worker A -> master: pocet URL ve fronte pred kazdou davkou stranek (prubeh obchodu)
+};
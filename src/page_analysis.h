@@ -0,0 +1,30 @@
+/**
+ * Vysledek analyzy jedne stranky - sdili ho crawler, MPI zpravy mezi Worker B a Worker A a zapis vysledku
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// Структура для зберігання результатів аналізу сторінки
+struct PageAnalysisResult {
+    std::string  url;
+    std::vector<std::string> foundUrls;
+    int imageCount;
+    int linkCount;
+    int formCount;
+    std::vector<std::pair<int, std::string>> headers; // рівень, текст
+    // otisky obsahu pro hledani duplicit (duplicate_index.h): presny hash HTML a SimHash textu (0 = prilis malo textu)
+    uint64_t contentHash = 0;
+    uint64_t simHash = 0;
+    // neprazdne = stranka je duplicitou stranky aliasOf; neobsahuje pak nadpisy ani odkazy a nezapisuje se jako uzel
+    std::string aliasOf;
+    // prubeh stazeni pro rizeni zateze hostitele (host_scheduler.h): HTTP status posledniho pokusu (0 = chyba spojeni),
+    // pocet odpovedi 429/503 pred nim a doba stazeni vcetne opakovani
+    int httpStatus = 0;
+    uint32_t throttledResponses = 0;
+    uint32_t fetchMs = 0;
+};
@@ -0,0 +1,76 @@
+/**
+ * Analyza stazene stranky - obrazky, formulare, nadpisy a odkazy v ramci obchazene domeny
+ */
+
+#include "page_analyzer.h"
+
+#include <iostream>
+
+#include "url_resolver.h"
+
+// documentBase - adresa, vuci ktere se resi relativni odkazy (URL stranky nebo <base href>)
+// baseUrl - hranice obchazeni z getBaseUrl
+std::pair<int, std::vector<std::string>> urlProcessingHtml(const std::vector<std::string>& hrefs, const std::string& documentBase, const std::string& baseUrl) {
+    int numberOfLinks = hrefs.size();
+
+    std::cout << "Seznam odkazů nalezených na zadané url adrese" << std::endl;
+    std::vector<std::string> links;
+    // jeden buffer pro vsechny odkazy stranky, kopie se vytvari jen pro prijate odkazy
+    std::string normalizedUrl;
+    for (const std::string& href : hrefs) {
+        // pri neuspechu (mailto:, javascript: ...) zustane normalizedUrl prazdny
+        resolveUrl(documentBase, href, normalizedUrl);
+
+        std::cout << "Cesta ke zdroji URI " << href << std::endl;
+        std::cout << "Úplná adresa nalezené stránky " << normalizedUrl << std::endl;
+
+        if (!normalizedUrl.empty() && isSameDomain(baseUrl, normalizedUrl)) {
+            links.push_back(normalizedUrl);
+        }
+    }
+
+    return std::make_pair(numberOfLinks, links);
+}
+
+// Аналіз уже просканованої сторінки (scanHtml або CHtmlStreamScanner під час завантаження)
+PageAnalysisResult analyzeScannedHtml(const std::string& url, HtmlScanResult scan) {
+    PageAnalysisResult result;
+    result.url = url;
+    result.imageCount = 0;
+    result.linkCount = 0;
+    result.formCount = 0;
+
+    std::string baseUrl = getBaseUrl(url);
+    std::cout << "url: " << url << "; baseUrl:" << baseUrl << std::endl;
+
+    // Відносні посилання розв'язуються відносно самої сторінки, або відносно <base href>, якщо є
+    std::string documentBase = url;
+    if (!scan.baseHref.empty()) {
+        std::string resolvedBase;
+        if (resolveUrl(url, scan.baseHref, resolvedBase)) {
+            documentBase = std::move(resolvedBase);
+        }
+    }
+
+    // Підрахунок зображень і форм
+    result.imageCount = scan.imageCount;
+    result.formCount = scan.formCount;
+
+    // Підрахунок посилань та збір URL
+    std::pair<int, std::vector<std::string>> urlProcessing = urlProcessingHtml(scan.hrefs, documentBase, baseUrl);
+    result.linkCount = urlProcessing.first;
+    result.foundUrls = urlProcessing.second;
+
+    // Заголовки вже очищені від вкладених тегів
+    result.headers = std::move(scan.headers);
+
+    return result;
+}
+
+// Функція для аналізу HTML-контенту
+PageAnalysisResult analyzeHtml(const std::string& url, const std::string& html) {
+    // Один прохід по буферу замість чотирьох регулярних виразів (див. html_scanner.h)
+    HtmlScanResult scan;
+    scanHtml(html, scan);
+    return analyzeScannedHtml(url, std::move(scan));
+}
@@ -0,0 +1,23 @@
+/**
+ * Analyza stazene stranky - obrazky, formulare, nadpisy a odkazy v ramci obchazene domeny
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "page_analysis.h"
+#include "html_scanner.h"
+
+// Обробка посилань сторінки - повертає кількість усіх посилань і ті, що ведуть у межах baseUrl
+// documentBase - adresa, vuci ktere se resi relativni odkazy (URL stranky nebo <base href>)
+// baseUrl - hranice obchazeni z getBaseUrl
+std::pair<int, std::vector<std::string>> urlProcessingHtml(const std::vector<std::string>& hrefs, const std::string& documentBase, const std::string& baseUrl);
+
+// Аналіз уже просканованої сторінки (scanHtml або CHtmlStreamScanner під час завантаження)
+PageAnalysisResult analyzeScannedHtml(const std::string& url, HtmlScanResult scan);
+
+// Функція для аналізу HTML-контенту
+PageAnalysisResult analyzeHtml(const std::string& url, const std::string& html);
@@ -0,0 +1,184 @@
+/**
+ * Archiv stazenych stranek ve stylu WARC - zapis pri obchazeni a cteni pri prehravani
+ */
+
+#include "page_archive.h"
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <random>
+#include <charconv>
+#include <ctime>
+
+namespace {
+	const char* const SegmentExtension = ".warc";
+	const char* const IndexExtension = ".idx";
+
+	// nahodny identifikator zapisovace - procesy zapisujici do stejneho archivu si neprepisi soubory
+	std::string newWriterId() {
+		std::random_device random;
+		uint64_t value = (static_cast<uint64_t>(random()) << 32) ^ random();
+		char digits[17];
+		auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, 16);
+		return std::string(digits, end);
+	}
+
+	std::string warcDate() {
+		std::time_t now = std::time(nullptr);
+		char buffer[32];
+		std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+		return buffer;
+	}
+
+	template <typename T>
+	bool parseNumber(std::string_view text, T& value) {
+		auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return ec == std::errc() && end == text.data() + text.size();
+	}
+}
+
+CPageArchiveWriter::CPageArchiveWriter(const std::string& directory, uint64_t segmentBytes)
+	: m_directory{ directory }, m_id{ newWriterId() }, m_segmentBytes{ segmentBytes } {
+	std::error_code ec;
+	std::filesystem::create_directories(m_directory, ec);
+
+	m_index = std::fopen((m_directory + "/" + m_id + IndexExtension).c_str(), "ab");
+	if (!m_index || !Open_Segment()) {
+		m_failed = true;
+	}
+}
+
+CPageArchiveWriter::~CPageArchiveWriter() {
+	if (m_segment) {
+		std::fclose(m_segment);
+	}
+	if (m_index) {
+		std::fclose(m_index);
+	}
+}
+
+bool CPageArchiveWriter::Open_Segment() {
+	if (m_segment) {
+		std::fclose(m_segment);
+	}
+	char number[8];
+	std::snprintf(number, sizeof(number), "%05zu", m_segmentNumber++);
+	m_segmentName = m_id + "-" + number + SegmentExtension;
+	m_segment = std::fopen((m_directory + "/" + m_segmentName).c_str(), "wb");
+	m_segmentOffset = 0;
+	return m_segment != nullptr;
+}
+
+bool CPageArchiveWriter::Append(const std::string& url, std::string_view html) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_failed) {
+		return false;
+	}
+	if (m_segmentOffset >= m_segmentBytes && !Open_Segment()) {
+		m_failed = true;
+		return false;
+	}
+
+	std::string header = "WARC/1.1\r\nWARC-Type: resource\r\nWARC-Target-URI: " + url
+		+ "\r\nWARC-Date: " + warcDate()
+		+ "\r\nContent-Type: text/html\r\nContent-Length: " + std::to_string(html.size()) + "\r\n\r\n";
+	const char trailer[] = "\r\n\r\n";
+
+	uint64_t contentOffset = m_segmentOffset + header.size();
+	bool written = std::fwrite(header.data(), 1, header.size(), m_segment) == header.size()
+		&& std::fwrite(html.data(), 1, html.size(), m_segment) == html.size()
+		&& std::fwrite(trailer, 1, sizeof(trailer) - 1, m_segment) == sizeof(trailer) - 1;
+	m_segmentOffset = contentOffset + html.size() + sizeof(trailer) - 1;
+	// propisuje se hned - cena je proti stazeni stranky zanedbatelna a archiv prezije i ukonceni serveru
+	written = written && std::fflush(m_segment) == 0;
+
+	// index az po propsani zaznamu - po padu muze zaznam v indexu chybet, ale neukazuje na chybejici data
+	std::string line = m_segmentName + " " + std::to_string(contentOffset) + " " + std::to_string(html.size()) + " " + url + "\n";
+	written = written && std::fwrite(line.data(), 1, line.size(), m_index) == line.size() && std::fflush(m_index) == 0;
+	if (!written) {
+		m_failed = true;
+		return false;
+	}
+	m_records++;
+	return true;
+}
+
+size_t CPageArchiveWriter::Records() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_records;
+}
+
+bool CPageArchiveReader::Open(const std::string& directory, std::string& error) {
+	m_segments.clear();
+	m_records.clear();
+
+	std::error_code ec;
+	std::vector<std::filesystem::path> indexes;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+		if (entry.is_regular_file() && entry.path().extension() == IndexExtension) {
+			indexes.push_back(entry.path());
+		}
+	}
+	if (ec) {
+		error = "Nelze cist adresar archivu: " + directory;
+		return false;
+	}
+	// starsi zapisovace driv - pozdejsi zaznam stejne URL prepise drivejsi
+	std::sort(indexes.begin(), indexes.end(), [](const auto& a, const auto& b) {
+		std::error_code ea;
+		std::error_code eb;
+		auto ta = std::filesystem::last_write_time(a, ea);
+		auto tb = std::filesystem::last_write_time(b, eb);
+		return ta != tb ? ta < tb : a < b;
+	});
+
+	std::unordered_map<std::string, uint32_t> segmentIds;
+	for (const auto& indexPath : indexes) {
+		std::ifstream index(indexPath);
+		std::string line;
+		while (std::getline(index, line)) {
+			// "<segment> <offset> <delka> <url>"
+			size_t first = line.find(' ');
+			size_t second = first == std::string::npos ? first : line.find(' ', first + 1);
+			size_t third = second == std::string::npos ? second : line.find(' ', second + 1);
+			if (third == std::string::npos) {
+				continue;
+			}
+			std::string_view view(line);
+			Record record;
+			if (!parseNumber(view.substr(first + 1, second - first - 1), record.offset)
+				|| !parseNumber(view.substr(second + 1, third - second - 1), record.length)) {
+				continue;
+			}
+
+			std::string segmentName = line.substr(0, first);
+			auto segment = segmentIds.find(segmentName);
+			if (segment == segmentIds.end()) {
+				auto file = std::make_unique<CMappedFile>();
+				std::string segmentError;
+				// chybejici segment - jeho zaznamy se preskoci (size 0)
+				file->Open((std::filesystem::path(directory) / segmentName).string(), segmentError);
+				segment = segmentIds.emplace(segmentName, static_cast<uint32_t>(m_segments.size())).first;
+				m_segments.push_back(std::move(file));
+			}
+			record.segment = segment->second;
+
+			if (record.offset > m_segments[record.segment]->Size() || record.length > m_segments[record.segment]->Size() - record.offset) {
+				continue;
+			}
+
+			m_records.insert_or_assign(line.substr(third + 1), record);
+		}
+	}
+	return true;
+}
+
+std::string_view CPageArchiveReader::Find(const std::string& url) const {
+	auto it = m_records.find(url);
+	if (it == m_records.end()) {
+		return {};
+	}
+	const CMappedFile& segment = *m_segments[it->second.segment];
+	return std::string_view(segment.Data() + it->second.offset, it->second.length);
+}
@@ -0,0 +1,95 @@
+/**
+ * Archiv stazenych stranek ve stylu WARC - stranky se pri obchazeni pripisuji do segmentu archivu
+ * a pri prehravani (replay) se ctou zpet bez pristupu k siti
+ *
+ * Adresar archivu obsahuje pro kazdy zapisovac (proces) segmenty "<id>-<cislo>.warc" a index "<id>.idx".
+ * Zaznam v segmentu:
+ *   WARC/1.1
+ *   WARC-Type: resource
+ *   WARC-Target-URI: <url>
+ *   WARC-Date: <cas UTC>
+ *   Content-Type: text/html
+ *   Content-Length: <delka>
+ *   <prazdny radek>
+ *   <HTML stranky>
+ *   <prazdny radek, prazdny radek>
+ * (konce radku hlavicky jsou CRLF jako ve WARC). Radek indexu: "<segment> <offset obsahu> <delka> <url>\n".
+ * Segmenty se jen pripisuji, takze do archivu muze soubezne zapisovat vice procesu (Worker B)
+ * a opakovane obchazeni jen prida nove segmenty - pri prehravani plati posledni zaznam URL.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#include "mapped_file.h"
+
+class CPageArchiveWriter {
+	public:
+		static constexpr uint64_t DefaultSegmentBytes = 256ull << 20;
+
+	private:
+		std::string m_directory;
+		// identifikator zapisovace - jmena jeho segmentu a indexu
+		std::string m_id;
+		uint64_t m_segmentBytes;
+
+		std::mutex m_mutex;
+		std::FILE* m_segment{ nullptr };
+		std::string m_segmentName;
+		uint64_t m_segmentOffset{ 0 };
+		size_t m_segmentNumber{ 0 };
+		std::FILE* m_index{ nullptr };
+
+		size_t m_records{ 0 };
+		bool m_failed{ false };
+
+		// uzavre aktualni segment a otevre dalsi
+		bool Open_Segment();
+
+	public:
+		// directory - adresar archivu (vytvori se); segmentBytes - po prekroceni teto velikosti zacne novy segment
+		explicit CPageArchiveWriter(const std::string& directory, uint64_t segmentBytes = DefaultSegmentBytes);
+		~CPageArchiveWriter();
+
+		CPageArchiveWriter(const CPageArchiveWriter&) = delete;
+		CPageArchiveWriter& operator=(const CPageArchiveWriter&) = delete;
+
+		bool Is_Open() const { return m_index != nullptr; }
+
+		// pripise stranku do archivu a propise ji na disk; lze volat z vice vlaken
+		bool Append(const std::string& url, std::string_view html);
+
+		size_t Records();
+};
+
+class CPageArchiveReader {
+	private:
+		struct Record {
+			uint32_t segment;
+			uint64_t offset;
+			uint64_t length;
+		};
+
+		std::vector<std::unique_ptr<CMappedFile>> m_segments;
+		std::unordered_map<std::string, Record> m_records;
+
+	public:
+		// nacte indexy vsech zapisovacu v adresari a namapuje segmenty; pri chybe vrati false a popis v error.
+		// Zaznamy za koncem segmentu (zapis prerusen padem) nebo v chybejicim segmentu se preskoci
+		bool Open(const std::string& directory, std::string& error);
+
+		// HTML stranky z archivu, nebo prazdny retezec, pokud stranka v archivu neni.
+		// Data jsou namapovana - plati po dobu zivota readeru; lze volat z vice vlaken
+		std::string_view Find(const std::string& url) const;
+
+		size_t Size() const { return m_records.size(); }
+};
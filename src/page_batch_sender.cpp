@@ -0,0 +1,50 @@
+/**
+ * Worker A: prubezne posilani vysledku stranek mastrovi v davkach (PAGE_BATCH)
+ */
+
+#include "page_batch_sender.h"
+#include "page_message.h"
+#include "mpi_protocol.h"
+
+#include <mpi.h>
+
+#include <cstdint>
+
+CPageBatchSender::CPageBatchSender(size_t maxBytes, size_t maxPages, std::chrono::steady_clock::duration interval)
+	: m_maxBytes{ maxBytes }, m_maxPages{ maxPages > 0 ? maxPages : 1 }, m_interval{ interval } {
+}
+
+void CPageBatchSender::Send(size_t queueDepth) {
+	uint64_t depth = queueDepth;
+	MPI_Send(&depth, 1, MPI_UINT64_T, 0, QUEUE_STATUS, MPI_COMM_WORLD);
+	MPI_Send(m_batch.data(), static_cast<int>(m_batch.size()), MPI_CHAR, 0, PAGE_BATCH, MPI_COMM_WORLD);
+
+	m_pagesSent += m_pages;
+	m_batch.clear();
+	m_pages = 0;
+	m_lastSend = std::chrono::steady_clock::now();
+}
+
+void CPageBatchSender::Add(const PageAnalysisResult& page, size_t queueDepth) {
+	appendPage(page, m_batch);
+	m_pages++;
+
+	if (m_batch.size() >= m_maxBytes || m_pages >= m_maxPages
+		|| std::chrono::steady_clock::now() - m_lastSend >= m_interval) {
+		Send(queueDepth);
+	}
+}
+
+void CPageBatchSender::Flush(size_t queueDepth) {
+	if (m_pages > 0) {
+		Send(queueDepth);
+	}
+}
+
+void CPageBatchSender::Finish() {
+	Flush(0);
+	// fronta domeny uz je prazdna; prazdna davka oznamuje konec
+	uint64_t depth = 0;
+	MPI_Send(&depth, 1, MPI_UINT64_T, 0, QUEUE_STATUS, MPI_COMM_WORLD);
+	MPI_Send(nullptr, 0, MPI_CHAR, 0, PAGE_BATCH, MPI_COMM_WORLD);
+}
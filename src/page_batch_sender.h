@@ -0,0 +1,42 @@
+/**
+ * Worker A: prubezne posilani vysledku stranek mastrovi v davkach (PAGE_BATCH)
+ *
+ * Davka se odesle, kdyz dosahne maxBytes nebo maxPages, nebo kdyz od posledniho odeslani uplynul interval.
+ * Pred kazdou davkou jde mastrovi pocet URL ve fronte (QUEUE_STATUS) pro hlaseni prubehu.
+ */
+
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+#include "page_analysis.h"
+
+class CPageBatchSender {
+	private:
+		size_t m_maxBytes;
+		size_t m_maxPages;
+		std::chrono::steady_clock::duration m_interval;
+
+		std::vector<char> m_batch;
+		size_t m_pages{ 0 };
+		size_t m_pagesSent{ 0 };
+		std::chrono::steady_clock::time_point m_lastSend{ std::chrono::steady_clock::now() };
+
+		void Send(size_t queueDepth);
+
+	public:
+		CPageBatchSender(size_t maxBytes, size_t maxPages, std::chrono::steady_clock::duration interval);
+
+		// prida stranku do davky a davku pripadne odesle; queueDepth - aktualni pocet URL ve fronte
+		void Add(const PageAnalysisResult& page, size_t queueDepth);
+
+		// odesle rozpracovanou davku, pokud neni prazdna
+		void Flush(size_t queueDepth);
+
+		// odesle zbytek a prazdnou davku = konec domeny
+		void Finish();
+
+		size_t Pages_Sent() const { return m_pagesSent; }
+};
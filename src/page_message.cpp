@@ -0,0 +1,283 @@
+/**
+ * Kompaktni binarni kodovani MPI zprav - PageAnalysisResult v jedne zprave, davky stranek a davky URL
+ */
+
+#include "page_message.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+	size_t varintSize(uint32_t value) {
+		size_t size = 1;
+		while (value >= 0x80) {
+			value >>= 7;
+			size++;
+		}
+		return size;
+	}
+
+	size_t stringSize(const std::string& s) {
+		return varintSize(static_cast<uint32_t>(s.size())) + s.size();
+	}
+
+	// zapisuje do predem spravne velikeho bufferu
+	class CWriter {
+		private:
+			char* m_pos;
+
+		public:
+			explicit CWriter(char* data) : m_pos{ data } {}
+
+			void Varint(uint32_t value) {
+				while (value >= 0x80) {
+					*m_pos++ = static_cast<char>((value & 0x7F) | 0x80);
+					value >>= 7;
+				}
+				*m_pos++ = static_cast<char>(value);
+			}
+
+			void Fixed64(uint64_t value) {
+				for (int i = 0; i < 8; i++) {
+					*m_pos++ = static_cast<char>(value >> (8 * i));
+				}
+			}
+
+			void String(const std::string& s) {
+				Varint(static_cast<uint32_t>(s.size()));
+				std::memcpy(m_pos, s.data(), s.size());
+				m_pos += s.size();
+			}
+	};
+
+	// cte s kontrolou mezi; po prvni chybe uz vsechna cteni selhavaji
+	class CReader {
+		private:
+			const char* m_pos;
+			const char* m_end;
+			bool m_ok{ true };
+
+		public:
+			CReader(const char* data, size_t size) : m_pos{ data }, m_end{ data + size } {}
+
+			bool Ok() const { return m_ok; }
+			bool At_End() const { return m_pos == m_end; }
+
+			uint32_t Varint() {
+				uint32_t value = 0;
+				for (int shift = 0; m_ok && shift < 35; shift += 7) {
+					if (m_pos == m_end) {
+						break;
+					}
+					uint8_t byte = static_cast<uint8_t>(*m_pos++);
+					value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0) {
+						return value;
+					}
+				}
+				m_ok = false;
+				return 0;
+			}
+
+			int Int() {
+				return static_cast<int>(Varint());
+			}
+
+			uint64_t Fixed64() {
+				if (!m_ok || m_end - m_pos < 8) {
+					m_ok = false;
+					return 0;
+				}
+				uint64_t value = 0;
+				for (int i = 0; i < 8; i++) {
+					value |= static_cast<uint64_t>(static_cast<uint8_t>(*m_pos++)) << (8 * i);
+				}
+				return value;
+			}
+
+			void String(std::string& out) {
+				uint32_t length = Varint();
+				if (!m_ok || static_cast<size_t>(m_end - m_pos) < length) {
+					m_ok = false;
+					out.clear();
+					return;
+				}
+				out.assign(m_pos, length);
+				m_pos += length;
+			}
+
+			// preskoci length bajtu a vrati ukazatel na jejich zacatek (nullptr, pokud tolik bajtu nezbyva)
+			const char* Skip(uint32_t length) {
+				if (!m_ok || static_cast<size_t>(m_end - m_pos) < length) {
+					m_ok = false;
+					return nullptr;
+				}
+				const char* start = m_pos;
+				m_pos += length;
+				return start;
+			}
+
+			// pocet prvku; kazdy prvek zabira alespon jeden bajt, vetsi pocet je jiste poskozeny
+			uint32_t Count() {
+				uint32_t count = Varint();
+				if (count > static_cast<size_t>(m_end - m_pos)) {
+					m_ok = false;
+					return 0;
+				}
+				return count;
+			}
+	};
+
+	void writePage(CWriter& writer, const PageAnalysisResult& result) {
+		writer.String(result.url);
+		writer.Varint(static_cast<uint32_t>(result.imageCount));
+		writer.Varint(static_cast<uint32_t>(result.linkCount));
+		writer.Varint(static_cast<uint32_t>(result.formCount));
+
+		writer.Varint(static_cast<uint32_t>(result.headers.size()));
+		for (const auto& header : result.headers) {
+			writer.Varint(static_cast<uint32_t>(header.first));
+			writer.String(header.second);
+		}
+
+		writer.Varint(static_cast<uint32_t>(result.foundUrls.size()));
+		for (const auto& url : result.foundUrls) {
+			writer.String(url);
+		}
+
+		writer.Fixed64(result.contentHash);
+		writer.Fixed64(result.simHash);
+		writer.String(result.aliasOf);
+
+		writer.Varint(static_cast<uint32_t>(result.httpStatus));
+		writer.Varint(result.throttledResponses);
+		writer.Varint(result.fetchMs);
+	}
+
+	void readPage(CReader& reader, PageAnalysisResult& result) {
+		reader.String(result.url);
+		result.imageCount = reader.Int();
+		result.linkCount = reader.Int();
+		result.formCount = reader.Int();
+
+		result.headers.resize(reader.Count());
+		for (auto& header : result.headers) {
+			header.first = reader.Int();
+			reader.String(header.second);
+		}
+
+		result.foundUrls.resize(reader.Count());
+		for (auto& url : result.foundUrls) {
+			reader.String(url);
+		}
+
+		result.contentHash = reader.Fixed64();
+		result.simHash = reader.Fixed64();
+		reader.String(result.aliasOf);
+
+		result.httpStatus = reader.Int();
+		result.throttledResponses = reader.Varint();
+		result.fetchMs = reader.Varint();
+	}
+}
+
+size_t encodedPageSize(const PageAnalysisResult& result) {
+	size_t size = stringSize(result.url);
+	size += varintSize(static_cast<uint32_t>(result.imageCount));
+	size += varintSize(static_cast<uint32_t>(result.linkCount));
+	size += varintSize(static_cast<uint32_t>(result.formCount));
+
+	size += varintSize(static_cast<uint32_t>(result.headers.size()));
+	for (const auto& header : result.headers) {
+		size += varintSize(static_cast<uint32_t>(header.first)) + stringSize(header.second);
+	}
+
+	size += varintSize(static_cast<uint32_t>(result.foundUrls.size()));
+	for (const auto& url : result.foundUrls) {
+		size += stringSize(url);
+	}
+
+	size += 2 * sizeof(uint64_t) + stringSize(result.aliasOf);
+	size += varintSize(static_cast<uint32_t>(result.httpStatus)) + varintSize(result.throttledResponses) + varintSize(result.fetchMs);
+	return size;
+}
+
+void encodePage(const PageAnalysisResult& result, std::vector<char>& out) {
+	out.resize(encodedPageSize(result));
+	CWriter writer(out.data());
+	writePage(writer, result);
+}
+
+bool decodePage(const char* data, size_t size, PageAnalysisResult& result) {
+	CReader reader(data, size);
+	readPage(reader, result);
+	return reader.Ok() && reader.At_End();
+}
+
+void appendPage(const PageAnalysisResult& result, std::vector<char>& batch) {
+	size_t pageSize = encodedPageSize(result);
+	size_t offset = batch.size();
+	batch.resize(offset + varintSize(static_cast<uint32_t>(pageSize)) + pageSize);
+
+	CWriter writer(batch.data() + offset);
+	writer.Varint(static_cast<uint32_t>(pageSize));
+	writePage(writer, result);
+}
+
+bool decodePages(const char* data, size_t size, std::vector<PageAnalysisResult>& pages) {
+	CReader reader(data, size);
+	while (reader.Ok() && !reader.At_End()) {
+		uint32_t pageSize = reader.Varint();
+		const char* pageData = reader.Skip(pageSize);
+		if (!pageData) {
+			return false;
+		}
+		// napul dekodovana stranka se do vysledku nedostane
+		if (!decodePage(pageData, pageSize, pages.emplace_back())) {
+			pages.pop_back();
+			return false;
+		}
+	}
+	return reader.Ok();
+}
+
+void encodeUrls(const std::vector<std::string>& urls, std::vector<char>& out) {
+	size_t size = varintSize(static_cast<uint32_t>(urls.size()));
+	for (const auto& url : urls) {
+		size += stringSize(url);
+	}
+	out.resize(size);
+
+	CWriter writer(out.data());
+	writer.Varint(static_cast<uint32_t>(urls.size()));
+	for (const auto& url : urls) {
+		writer.String(url);
+	}
+}
+
+bool decodeUrls(const char* data, size_t size, std::vector<std::string>& urls) {
+	CReader reader(data, size);
+	urls.resize(reader.Count());
+	for (auto& url : urls) {
+		reader.String(url);
+	}
+	return reader.Ok() && reader.At_End();
+}
+
+std::vector<char> CMessageBufferPool::Acquire(size_t size) {
+	std::vector<char> buffer;
+	if (!m_free.empty()) {
+		buffer = std::move(m_free.back());
+		m_free.pop_back();
+	}
+	if (buffer.capacity() < size) {
+		m_allocations++;
+	}
+	buffer.resize(size);
+	return buffer;
+}
+
+void CMessageBufferPool::Release(std::vector<char> buffer) {
+	m_free.push_back(std::move(buffer));
+}
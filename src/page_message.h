@@ -0,0 +1,60 @@
+/**
+ * Kompaktni binarni kodovani MPI zprav - PageAnalysisResult v jedne zprave, davky stranek a davky URL
+ *
+ * Format (vsechna cisla jako LEB128 varint, retezce s prefixem delky):
+ *   url, imageCount, linkCount, formCount,
+ *   pocet nadpisu, [uroven, text] ...,
+ *   pocet nalezenych URL, [url] ...,
+ *   contentHash, simHash (8 bajtu little-endian), aliasOf,
+ *   httpStatus, throttledResponses, fetchMs
+ * Davka stranek: [delka zakodovane stranky, stranka] ...
+ * Davka URL: pocet URL, [url] ...
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "page_analysis.h"
+
+// presna delka zakodovaneho vysledku v bajtech
+size_t encodedPageSize(const PageAnalysisResult& result);
+
+// zakoduje vysledek do out (out se prepise, jeho kapacita se znovu pouzije)
+void encodePage(const PageAnalysisResult& result, std::vector<char>& out);
+
+// dekoduje zpravu do result (vektory v result se vyprazdni a znovu pouziji);
+// vraci false, pokud je zprava zkracena nebo poskozena
+bool decodePage(const char* data, size_t size, PageAnalysisResult& result);
+
+// prida vysledek do davky stranek (delka zakodovaneho vysledku jako varint a za ni vysledek)
+void appendPage(const PageAnalysisResult& result, std::vector<char>& batch);
+
+// dekoduje davku stranek a prida je na konec pages; vraci false, pokud je davka poskozena -
+// pages pak obsahuje jen stranky pred poskozenym mistem, dekodovane cele
+bool decodePages(const char* data, size_t size, std::vector<PageAnalysisResult>& pages);
+
+// zakoduje seznam URL (pocet a URL s prefixem delky) do out
+void encodeUrls(const std::vector<std::string>& urls, std::vector<char>& out);
+
+// dekoduje seznam URL do urls (urls se vyprazdni); vraci false, pokud je zprava poskozena
+bool decodeUrls(const char* data, size_t size, std::vector<std::string>& urls);
+
+// zasobnik prijimacich bufferu - Worker A nealokuje novy buffer pro kazdou zpravu
+class CMessageBufferPool {
+	private:
+		std::vector<std::vector<char>> m_free;
+		size_t m_allocations{ 0 };
+
+	public:
+		// vrati buffer s velikosti alespon size (obsah je nedefinovany)
+		std::vector<char> Acquire(size_t size);
+
+		// vrati buffer zpet do zasobniku
+		void Release(std::vector<char> buffer);
+
+		// kolikrat musel Acquire zvetsit nebo vytvorit buffer
+		size_t Allocations() const { return m_allocations; }
+};
@@ -0,0 +1,54 @@
+/**
+ * Pomocne struktury pro zretezene (pipeline) zpracovani stahovani a analyzy
+ */
+
+#include "pipeline.h"
+
+void CStageTimer::Advance() {
+	Clock::time_point now = Clock::now();
+	Clock::duration elapsed = now - m_last;
+	m_last = now;
+
+	if (m_activeDownloads > 0 && m_analyzing) {
+		m_stats.overlap += elapsed;
+	}
+	else if (m_activeDownloads > 0) {
+		m_stats.downloadOnly += elapsed;
+	}
+	else if (m_analyzing) {
+		m_stats.analyzeOnly += elapsed;
+	}
+	else {
+		m_stats.idle += elapsed;
+	}
+}
+
+void CStageTimer::Begin_Download() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Advance();
+	m_activeDownloads++;
+}
+
+void CStageTimer::End_Download() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Advance();
+	m_activeDownloads--;
+}
+
+void CStageTimer::Begin_Analyze() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Advance();
+	m_analyzing = true;
+}
+
+void CStageTimer::End_Analyze() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Advance();
+	m_analyzing = false;
+}
+
+CStageTimer::Stats CStageTimer::Finish() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Advance();
+	return m_stats;
+}
@@ -0,0 +1,104 @@
+/**
+ * Pomocne struktury pro zretezene (pipeline) zpracovani stahovani a analyzy
+ */
+
+#pragma once
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <chrono>
+#include <cstddef>
+
+// omezena fronta mezi vlakny jednotlivych stupnu; Push blokuje pri plne fronte, Pop pri prazdne
+template<typename T>
+class BoundedQueue {
+	private:
+		std::queue<T> m_items;
+		size_t m_capacity;
+		bool m_closed{ false };
+
+		std::mutex m_mutex;
+		std::condition_variable m_notEmpty;
+		std::condition_variable m_notFull;
+
+	public:
+		explicit BoundedQueue(size_t capacity) : m_capacity{ capacity > 0 ? capacity : 1 } {}
+
+		// vlozi prvek, pri plne fronte ceka; vraci false, pokud byla fronta uzavrena
+		bool Push(T item) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_notFull.wait(lock, [this]() { return m_closed || m_items.size() < m_capacity; });
+			if (m_closed) {
+				return false;
+			}
+			m_items.push(std::move(item));
+			m_notEmpty.notify_one();
+			return true;
+		}
+
+		// vlozi prvek jen pokud je ve fronte misto; nikdy neceka
+		bool Try_Push(T& item) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_closed || m_items.size() >= m_capacity) {
+				return false;
+			}
+			m_items.push(std::move(item));
+			m_notEmpty.notify_one();
+			return true;
+		}
+
+		// vyjme prvek, pri prazdne fronte ceka; po uzavreni a vyprazdneni vraci std::nullopt
+		std::optional<T> Pop() {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_notEmpty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+			if (m_items.empty()) {
+				return std::nullopt;
+			}
+			T item = std::move(m_items.front());
+			m_items.pop();
+			m_notFull.notify_one();
+			return item;
+		}
+
+		// uzavre frontu a probudi vsechna cekajici vlakna
+		void Close() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_closed = true;
+			m_notEmpty.notify_all();
+			m_notFull.notify_all();
+		}
+};
+
+// meri, jak dlouho bezelo stahovani, analyza a jak dlouho obe soucasne
+class CStageTimer {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		struct Stats {
+			Clock::duration downloadOnly{};  // bezelo jen stahovani
+			Clock::duration analyzeOnly{};   // bezela jen analyza
+			Clock::duration overlap{};       // stahovani i analyza soucasne
+			Clock::duration idle{};          // nebezelo nic
+		};
+
+	private:
+		std::mutex m_mutex;
+		int m_activeDownloads{ 0 };
+		bool m_analyzing{ false };
+		Clock::time_point m_last{ Clock::now() };
+		Stats m_stats;
+
+		// pripise cas od posledni zmeny stavu odpovidajicimu citaci; volat se zamcenym m_mutex
+		void Advance();
+
+	public:
+		void Begin_Download();
+		void End_Download();
+		void Begin_Analyze();
+		void End_Analyze();
+
+		// uzavre posledni usek a vrati namerene casy
+		Stats Finish();
+};
@@ -0,0 +1,152 @@
+/**
+ * Cache validatoru a vysledku analyzy pro podmineny GET pri opakovanem obchazeni
+ */
+
+#include "recrawl_cache.h"
+
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+#include "page_message.h"
+
+namespace {
+	// verze 2: stranky obsahuji otisky obsahu (contentHash, simHash); verze 3: prubeh stazeni (httpStatus ...)
+	constexpr char Magic[8] = { 'U', 'P', 'P', 'R', 'C', '3', '\0', '\0' };
+
+	struct Header {
+		char magic[8];
+		uint64_t pagesBytes;
+		uint64_t validatorsBytes;
+	};
+}
+
+CRecrawlCache& CRecrawlCache::Instance() {
+	static CRecrawlCache instance;
+	return instance;
+}
+
+bool CRecrawlCache::Load(const std::string& path) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_enabled = true;
+
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return true;
+	}
+
+	std::error_code ec;
+	uint64_t fileSize = std::filesystem::file_size(path, ec);
+	Header header;
+	if (ec || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+		return false;
+	}
+	// velikosti sekci musi odpovidat souboru - poskozena hlavicka nesmi vest k obri alokaci
+	uint64_t dataSize = fileSize - sizeof(header);
+	if (header.pagesBytes > dataSize || header.validatorsBytes != dataSize - header.pagesBytes) {
+		return false;
+	}
+	std::vector<char> pagesData(header.pagesBytes);
+	std::vector<char> validatorsData(header.validatorsBytes);
+	if (!in.read(pagesData.data(), static_cast<std::streamsize>(pagesData.size()))
+		|| !in.read(validatorsData.data(), static_cast<std::streamsize>(validatorsData.size()))) {
+		return false;
+	}
+
+	std::vector<PageAnalysisResult> pages;
+	std::vector<std::string> validators;
+	if (!decodePages(pagesData.data(), pagesData.size(), pages)
+		|| !decodeUrls(validatorsData.data(), validatorsData.size(), validators)
+		|| validators.size() != 2 * pages.size()) {
+		return false;
+	}
+
+	m_entries.reserve(pages.size());
+	for (size_t i = 0; i < pages.size(); i++) {
+		std::string url = pages[i].url;
+		m_entries.insert_or_assign(std::move(url), Entry{ std::move(validators[2 * i]), std::move(validators[2 * i + 1]), std::move(pages[i]) });
+	}
+	return true;
+}
+
+bool CRecrawlCache::Save(const std::string& path) const {
+	std::vector<char> pages;
+	std::vector<std::string> validators;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		validators.reserve(2 * m_entries.size());
+		for (const auto& [url, entry] : m_entries) {
+			appendPage(entry.analysis, pages);
+			validators.push_back(entry.etag);
+			validators.push_back(entry.lastModified);
+		}
+	}
+	std::vector<char> validatorsData;
+	encodeUrls(validators, validatorsData);
+
+	Header header{};
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.pagesBytes = pages.size();
+	header.validatorsBytes = validatorsData.size();
+
+	std::string tmpPath = path + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(pages.data(), static_cast<std::streamsize>(pages.size()));
+		out.write(validatorsData.data(), static_cast<std::streamsize>(validatorsData.size()));
+		if (!out) {
+			return false;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	return !ec;
+}
+
+bool CRecrawlCache::Get_Validators(const std::string& url, std::string& etag, std::string& lastModified) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(url);
+	if (it == m_entries.end()) {
+		return false;
+	}
+	etag = it->second.etag;
+	lastModified = it->second.lastModified;
+	return true;
+}
+
+bool CRecrawlCache::Reuse(const std::string& url, PageAnalysisResult& analysis) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_entries.find(url);
+	if (it == m_entries.end()) {
+		return false;
+	}
+	analysis = it->second.analysis;
+	m_stats.revalidated++;
+	return true;
+}
+
+void CRecrawlCache::Store(const std::string& url, const std::string& etag, const std::string& lastModified, const PageAnalysisResult& analysis) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_enabled) {
+		return;
+	}
+	m_stats.refetched++;
+	if (etag.empty() && lastModified.empty()) {
+		return;
+	}
+	m_entries.insert_or_assign(url, Entry{ etag, lastModified, analysis });
+}
+
+CRecrawlCache::Stats CRecrawlCache::Get_Stats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+size_t CRecrawlCache::Size() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
@@ -0,0 +1,73 @@
+/**
+ * Cache pro inkrementalni opakovane obchazeni - pro kazdou URL validatory (ETag, Last-Modified) a vysledek
+ * analyzy z predchozich behu
+ *
+ * Pri dalsim obchazeni se strance poslou validatory jako podmineny GET; kdyz server odpovi 304, pouzije se
+ * ulozena analyza a stranka se znovu nestahuje ani neanalyzuje.
+ *
+ * Format souboru (little-endian):
+ *   magic "UPPRC3\0\0", velikost davky stranek (uint64), velikost seznamu validatoru (uint64),
+ *   davka stranek (appendPage, page_message.h), seznam validatoru (encodeUrls) - ETag a Last-Modified
+ *   pro kazdou stranku davky ve stejnem poradi
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+
+#include "page_analysis.h"
+
+class CRecrawlCache {
+	public:
+		struct Stats {
+			// stranky potvrzene odpovedi 304 - pouzita ulozena analyza
+			size_t revalidated = 0;
+			// stranky stazene cele (odpoved 200)
+			size_t refetched = 0;
+		};
+
+	private:
+		struct Entry {
+			std::string etag;
+			std::string lastModified;
+			PageAnalysisResult analysis;
+		};
+
+		mutable std::mutex m_mutex;
+		std::unordered_map<std::string, Entry> m_entries;
+		// bez Load se cache nepouziva (napr. Worker B v MPI verzi)
+		bool m_enabled{ false };
+		Stats m_stats;
+
+		CRecrawlCache() = default;
+
+	public:
+		static CRecrawlCache& Instance();
+
+		CRecrawlCache(const CRecrawlCache&) = delete;
+		CRecrawlCache& operator=(const CRecrawlCache&) = delete;
+
+		// nacte cache z predchozich behu a zapne ji; chybejici soubor = prazdna cache.
+		// Vraci false, pokud je soubor poskozeny (cache pak zustane prazdna)
+		bool Load(const std::string& path);
+
+		// zapise cache (pres docasny soubor, aby pad nezanechal poskozenou cache)
+		bool Save(const std::string& path) const;
+
+		// validatory pro podmineny GET; vraci false, pokud URL v cache neni
+		bool Get_Validators(const std::string& url, std::string& etag, std::string& lastModified) const;
+
+		// odpoved 304: zkopiruje ulozenou analyzu do analysis; vraci false, pokud URL v cache neni
+		bool Reuse(const std::string& url, PageAnalysisResult& analysis);
+
+		// odpoved 200: zapocita stazeni a ulozi validatory s novou analyzou (stranka bez validatoru se neuklada)
+		void Store(const std::string& url, const std::string& etag, const std::string& lastModified, const PageAnalysisResult& analysis);
+
+		// pocitadla od spusteni programu
+		Stats Get_Stats() const;
+
+		size_t Size() const;
+};
@@ -0,0 +1,103 @@
+/**
+ * Kompaktni uloziste vysledku obchazeni
+ */
+
+#include "result_store.h"
+
+UrlId CResultStore::Intern_Url(std::string_view url) {
+	UrlId id = m_urls.Intern(url).first;
+	if (id >= m_pageOf.size()) {
+		m_pageOf.resize(id + 1, NoPage);
+	}
+	return id;
+}
+
+CResultStore::Record& CResultStore::Record_For(std::string_view url) {
+	UrlId id = Intern_Url(url);
+	if (m_pageOf[id] == NoPage) {
+		m_pageOf[id] = static_cast<PageIndex>(m_records.size());
+		m_records.emplace_back();
+	}
+	Record& record = m_records[m_pageOf[id]];
+	record = Record{};
+	record.url = id;
+	return record;
+}
+
+void CResultStore::Add(std::string_view url, const PageAnalysisResult& page) {
+	// ID se internuji pred ziskanim reference - Intern_Url zvetsuje m_pageOf, ne m_records
+	UrlId alias = page.aliasOf.empty() ? NoAlias : Intern_Url(page.aliasOf);
+	uint32_t firstLink = static_cast<uint32_t>(m_links.size());
+	for (const std::string& target : page.foundUrls) {
+		m_links.push_back(Intern_Url(target));
+	}
+	uint32_t firstHeader = static_cast<uint32_t>(m_headers.size());
+	for (const auto& [level, text] : page.headers) {
+		m_headers.push_back({ m_texts.Intern(text).first, level });
+	}
+
+	Record& record = Record_For(url);
+	record.aliasOf = alias;
+	record.firstLink = firstLink;
+	record.links = static_cast<uint32_t>(page.foundUrls.size());
+	record.firstHeader = firstHeader;
+	record.headers = static_cast<uint32_t>(page.headers.size());
+	record.imageCount = page.imageCount;
+	record.linkCount = page.linkCount;
+	record.formCount = page.formCount;
+}
+
+void CResultStore::Add(const CResultStore& other, PageIndex page) {
+	const Record& source = other.m_records[page];
+
+	UrlId alias = source.aliasOf == NoAlias ? NoAlias : Intern_Url(other.m_urls.View(source.aliasOf));
+	uint32_t firstLink = static_cast<uint32_t>(m_links.size());
+	for (UrlId target : other.Links(page)) {
+		m_links.push_back(Intern_Url(other.m_urls.View(target)));
+	}
+	uint32_t firstHeader = static_cast<uint32_t>(m_headers.size());
+	for (const Header& header : other.Headers(page)) {
+		m_headers.push_back({ m_texts.Intern(other.Header_Text(header)).first, header.level });
+	}
+
+	Record& record = Record_For(other.Url(page));
+	record.aliasOf = alias;
+	record.firstLink = firstLink;
+	record.links = source.links;
+	record.firstHeader = firstHeader;
+	record.headers = source.headers;
+	record.imageCount = source.imageCount;
+	record.linkCount = source.linkCount;
+	record.formCount = source.formCount;
+}
+
+std::optional<CResultStore::PageIndex> CResultStore::Find(std::string_view url) const {
+	std::optional<UrlId> id = m_urls.Find(url);
+	return id ? Page_Of(*id) : std::nullopt;
+}
+
+PageAnalysisResult CResultStore::Materialize(PageIndex page) const {
+	const Record& record = m_records[page];
+	PageAnalysisResult result;
+	result.url = Url(page);
+	result.aliasOf = Alias_Of(page);
+	result.imageCount = record.imageCount;
+	result.linkCount = record.linkCount;
+	result.formCount = record.formCount;
+	for (UrlId target : Links(page)) {
+		result.foundUrls.emplace_back(m_urls.View(target));
+	}
+	for (const Header& header : Headers(page)) {
+		result.headers.emplace_back(header.level, std::string(Header_Text(header)));
+	}
+	return result;
+}
+
+size_t CResultStore::Memory_Usage() const {
+	return m_urls.Memory_Usage()
+		+ m_texts.Memory_Usage()
+		+ m_records.capacity() * sizeof(Record)
+		+ m_links.capacity() * sizeof(UrlId)
+		+ m_headers.capacity() * sizeof(Header)
+		+ m_pageOf.capacity() * sizeof(PageIndex);
+}
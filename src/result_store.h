@@ -0,0 +1,132 @@
+/**
+ * Kompaktni uloziste vysledku obchazeni (lokalni rezimy) - misto std::unordered_map<std::string, PageAnalysisResult>
+ *
+ * Kazda stranka je zaznam pevne velikosti (Record). URL stranek, aliasu i cilu odkazu jsou internovane
+ * v jedne CUrlTable - odkaz je 32bitove ID a cil, na ktery odkazuje mnoho stranek (navigace webu), je ulozen jednou.
+ * Texty nadpisu jsou internovane ve druhe tabulce (opakuji se stejne jako navigace) a seznamy odkazu a nadpisu
+ * vsech stranek lezi za sebou ve spolecnych polich, zaznam na ne odkazuje posunem a poctem.
+ *
+ * Uklada se jen to, co potrebuje zapis vysledku (map.txt, content.txt, aliases.txt); otisky obsahu
+ * a prubeh stazeni se pouzivaji jen behem obchazeni. Stranky se prochazi v poradi prvniho vlozeni.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+
+#include "page_analysis.h"
+#include "url_table.h"
+
+class CResultStore {
+	public:
+		// poradi stranky v ulozisti (poradi prvniho vlozeni)
+		using PageIndex = uint32_t;
+
+		static constexpr UrlId NoAlias = UINT32_MAX;
+
+		struct Header {
+			UrlId text;   // ID v tabulce textu nadpisu
+			int level;
+		};
+
+		struct Record {
+			UrlId url;
+			// puvodni stranka duplicity; NoAlias = stranka neni duplicita
+			UrlId aliasOf = NoAlias;
+			// cile odkazu: m_links[firstLink, firstLink + links)
+			uint32_t firstLink = 0;
+			uint32_t links = 0;
+			// nadpisy: m_headers[firstHeader, firstHeader + headers)
+			uint32_t firstHeader = 0;
+			uint32_t headers = 0;
+			int imageCount = 0;
+			int linkCount = 0;
+			int formCount = 0;
+		};
+
+	private:
+		CUrlTable m_urls;
+		CUrlTable m_texts;
+		std::vector<Record> m_records;
+		std::vector<UrlId> m_links;
+		std::vector<Header> m_headers;
+		// stranka podle ID URL; ID, ktere je jen cilem odkazu, nema stranku (NoPage)
+		std::vector<PageIndex> m_pageOf;
+
+		static constexpr PageIndex NoPage = UINT32_MAX;
+
+		// vlozi prazdny zaznam stranky url, nebo vrati existujici (ten se prepise)
+		Record& Record_For(std::string_view url);
+
+		UrlId Intern_Url(std::string_view url);
+
+	public:
+		// vlozi vysledek stranky url; stranka, ktera uz v ulozisti je, se prepise a zustane na svem miste.
+		// Odkazy a nadpisy prepsane stranky zustanou v polich nevyuzite (opakovane obchazeni stejne domeny)
+		void Add(std::string_view url, const PageAnalysisResult& page);
+
+		// zkopiruje stranku z jineho uloziste (vysledky vlaken work-stealing)
+		void Add(const CResultStore& other, PageIndex page);
+
+		std::optional<PageIndex> Find(std::string_view url) const;
+
+		size_t Size() const {
+			return m_records.size();
+		}
+
+		const Record& Get(PageIndex page) const {
+			return m_records[page];
+		}
+
+		std::string_view Url(PageIndex page) const {
+			return m_urls.View(m_records[page].url);
+		}
+
+		// prazdny pohled = stranka neni duplicita
+		std::string_view Alias_Of(PageIndex page) const {
+			UrlId alias = m_records[page].aliasOf;
+			return alias == NoAlias ? std::string_view() : m_urls.View(alias);
+		}
+
+		// pohledy do poli plati, dokud se do uloziste nevklada
+		std::span<const UrlId> Links(PageIndex page) const {
+			const Record& record = m_records[page];
+			return std::span<const UrlId>(m_links.data() + record.firstLink, record.links);
+		}
+
+		std::span<const Header> Headers(PageIndex page) const {
+			const Record& record = m_records[page];
+			return std::span<const Header>(m_headers.data() + record.firstHeader, record.headers);
+		}
+
+		// text URL (stranky, aliasu nebo cile odkazu) podle ID
+		std::string_view Url_Text(UrlId url) const {
+			return m_urls.View(url);
+		}
+
+		std::string_view Header_Text(const Header& header) const {
+			return m_texts.View(header.text);
+		}
+
+		// pocet internovanych URL (ID jsou 0 .. Url_Count() - 1) - pro pole indexovana ID URL
+		size_t Url_Count() const {
+			return m_urls.Size();
+		}
+
+		// stranka s danym ID URL; nullopt, pokud je URL jen cilem odkazu
+		std::optional<PageIndex> Page_Of(UrlId url) const {
+			return url < m_pageOf.size() && m_pageOf[url] != NoPage ? std::optional<PageIndex>(m_pageOf[url]) : std::nullopt;
+		}
+
+		// vysledek stranky ve tvaru PageAnalysisResult (bez otisku obsahu a prubehu stazeni)
+		PageAnalysisResult Materialize(PageIndex page) const;
+
+		// pocet bajtu alokovanych ulozistem
+		size_t Memory_Usage() const;
+};
@@ -0,0 +1,218 @@
+/**
+ * Prubezny zapis vysledku jedne domeny do map.txt, content.txt, graph.bin, aliases.txt a log.txt
+ */
+
+#include "result_writer.h"
+
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+namespace {
+	const char* const MapFileName = "/map.txt";
+	const char* const ContentFileName = "/content.txt";
+	const char* const LogFileName = "/log.txt";
+	const char* const GraphFileName = "/graph.bin";
+	const char* const AliasesFileName = "/aliases.txt";
+	// docasny soubor hran; po Finish uz neexistuje
+	const char* const EdgesFileName = "/map.edges.tmp";
+	// kolik stranek se formatuje najednou (rozdeleno mezi vlakna) - omezuje pamet bufferu
+	const size_t FormatBlockPages = 16384;
+}
+
+CResultWriter::CResultWriter(const std::string& resultDir)
+	: m_resultDir{ resultDir },
+	  m_map(resultDir + MapFileName),
+	  m_content(resultDir + ContentFileName),
+	  m_edges(resultDir + EdgesFileName) {
+}
+
+CResultWriter::~CResultWriter() {
+	// nedokonceny zapis (chyba obchodu) - aspon propsat, co uz prislo
+	if (!m_finished) {
+		Flush();
+	}
+}
+
+bool CResultWriter::Is_Open() const {
+	return m_map.Is_Open() && m_content.Is_Open() && m_edges.Is_Open();
+}
+
+bool CResultWriter::Add_Page(const PageAnalysisResult& page) {
+	if (m_pages.find(page.url) != m_pages.end() || m_aliases.find(page.url) != m_aliases.end()) {
+		return false;
+	}
+	if (!page.aliasOf.empty()) {
+		if (!m_aliasFile) {
+			m_aliasFile = std::make_unique<CBufferedFileWriter>(m_resultDir + AliasesFileName);
+		}
+		appendEdgeLine(m_aliasFile->Buffer(), page.url, page.aliasOf);
+		m_aliasFile->Commit();
+		m_aliases.emplace(page.url, page.aliasOf);
+		return true;
+	}
+	m_pages.emplace(page.url, m_graph.Add_Node(page.url));
+
+	appendNodeLine(m_map.Buffer(), page.url);
+	m_map.Commit();
+	appendContentRecord(m_content.Buffer(), page.url, page);
+	m_content.Commit();
+	for (const std::string& target : page.foundUrls) {
+		appendNodeLine(m_edges.Buffer(), page.url);
+		appendNodeLine(m_edges.Buffer(), target);
+	}
+	m_edges.Commit();
+	return true;
+}
+
+void CResultWriter::Flush() {
+	m_map.Flush();
+	m_content.Flush();
+	m_edges.Flush();
+	if (m_aliasFile) {
+		m_aliasFile->Flush();
+	}
+}
+
+void CResultWriter::Finish(const std::string& startTime, const std::string& endTime) {
+	m_content.Close();
+	m_edges.Close();
+	if (m_aliasFile) {
+		m_aliasFile->Close();
+	}
+
+	// hrany ve stejnem poradi jako createWebGraph - po strankach v poradi uzlu, jen na obchazene stranky
+	{
+		std::ifstream edges(m_resultDir + EdgesFileName);
+		std::string source;
+		std::string target;
+		std::string previousSource;
+		uint32_t sourceNode = 0;
+		while (std::getline(edges, source) && std::getline(edges, target)) {
+			// odkaz na duplicitu vede na puvodni stranku
+			auto alias = m_aliases.find(target);
+			if (alias != m_aliases.end()) {
+				target = alias->second;
+			}
+			auto targetIt = m_pages.find(target);
+			if (targetIt == m_pages.end()) {
+				continue;
+			}
+			appendEdgeLine(m_map.Buffer(), source, target);
+			m_map.Commit();
+
+			// hrany jednoho zdroje jdou za sebou, index zdroje se hleda jen pri zmene;
+			// zdroj je vzdy zapsana stranka (hrany zapisuje jen Add_Page)
+			if (source != previousSource) {
+				sourceNode = m_pages.at(source);
+				previousSource = source;
+			}
+			m_graph.Add_Edge(sourceNode, targetIt->second);
+		}
+	}
+	m_map.Close();
+	m_graph.Write(m_resultDir + GraphFileName);
+
+	std::error_code ec;
+	std::filesystem::remove(m_resultDir + EdgesFileName, ec);
+
+	std::ofstream logFile(m_resultDir + LogFileName);
+	logFile << startTime << '\n';
+	logFile << endTime << '\n';
+	logFile << "OK" << '\n';
+
+	m_finished = true;
+}
+
+bool writeWebGraph(const std::string& resultDir, const CResultStore& store, size_t threads) {
+	CBufferedFileWriter map(resultDir + MapFileName);
+	// stejny graf binarne (CSR) pro rychle nacteni - viz link_graph.h
+	CLinkGraphBuilder graph;
+	// uzel podle ID URL - stranky i cile odkazu sdileji ID, takze hrany se hledaji v poli misto hashovaci tabulky
+	constexpr uint32_t NoNode = UINT32_MAX;
+	std::vector<uint32_t> nodeOf(store.Url_Count(), NoNode);
+
+	// uzly jsou jen puvodni stranky; index uzlu = index v pages
+	std::vector<CResultStore::PageIndex> pages;
+	std::vector<CResultStore::PageIndex> aliases;
+	pages.reserve(store.Size());
+	for (CResultStore::PageIndex page = 0; page < store.Size(); page++) {
+		(store.Get(page).aliasOf == CResultStore::NoAlias ? pages : aliases).push_back(page);
+	}
+
+	for (CResultStore::PageIndex page : pages) {
+		nodeOf[store.Get(page).url] = graph.Add_Node(store.Url(page));
+		appendNodeLine(map.Buffer(), store.Url(page));
+		map.Commit();
+	}
+
+	// odkazy na duplicitu vedou na puvodni stranku
+	bool aliasesWritten = true;
+	if (!aliases.empty()) {
+		CBufferedFileWriter aliasFile(resultDir + AliasesFileName);
+		for (CResultStore::PageIndex alias : aliases) {
+			appendEdgeLine(aliasFile.Buffer(), store.Url(alias), store.Alias_Of(alias));
+			aliasFile.Commit();
+			nodeOf[store.Get(alias).url] = nodeOf[store.Get(alias).aliasOf];
+		}
+		aliasFile.Close();
+		aliasesWritten = aliasFile.Good();
+	}
+
+	// hrany useku: text pro map.txt a dvojice (zdroj, cil) pro graf - graf se plni az v poradi useku
+	struct EdgeChunk {
+		std::string text;
+		std::vector<std::pair<uint32_t, uint32_t>> edges;
+	};
+	formatParallel<EdgeChunk>(pages.size(), threads, FormatBlockPages,
+		[&pages, &nodeOf, &store](EdgeChunk& chunk, size_t begin, size_t end) {
+			chunk.text.clear();
+			chunk.edges.clear();
+			for (size_t source = begin; source < end; source++) {
+				std::string_view sourceUrl = store.Url(pages[source]);
+				for (UrlId targetUrl : store.Links(pages[source])) {
+					uint32_t target = nodeOf[targetUrl];
+					if (target != NoNode) {
+						appendEdgeLine(chunk.text, sourceUrl, store.Url(pages[target]));
+						chunk.edges.emplace_back(static_cast<uint32_t>(source), target);
+					}
+				}
+			}
+		},
+		[&map, &graph](EdgeChunk& chunk) {
+			map.Append(chunk.text);
+			for (const auto& [source, target] : chunk.edges) {
+				graph.Add_Edge(source, target);
+			}
+		});
+	map.Close();
+
+	bool graphWritten = graph.Write(resultDir + GraphFileName);
+	return map.Good() && graphWritten && aliasesWritten;
+}
+
+bool writeContent(const std::string& resultDir, const CResultStore& store, size_t threads) {
+	CBufferedFileWriter content(resultDir + ContentFileName);
+
+	formatParallel<std::string>(store.Size(), threads, FormatBlockPages,
+		[&store](std::string& chunk, size_t begin, size_t end) {
+			chunk.clear();
+			for (size_t i = begin; i < end; i++) {
+				CResultStore::PageIndex page = static_cast<CResultStore::PageIndex>(i);
+				const CResultStore::Record& record = store.Get(page);
+				if (record.aliasOf != CResultStore::NoAlias) {
+					continue;
+				}
+				appendContentHead(chunk, store.Url(page), record.imageCount, record.linkCount, record.formCount);
+				for (const CResultStore::Header& header : store.Headers(page)) {
+					appendHeaderLine(chunk, header.level, store.Header_Text(header));
+				}
+				chunk.push_back('\n');
+			}
+		},
+		[&content](std::string& chunk) {
+			content.Append(chunk);
+		});
+	content.Close();
+	return content.Good();
+}
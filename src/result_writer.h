@@ -0,0 +1,75 @@
+/**
+ * Prubezny zapis vysledku jedne domeny do map.txt, content.txt, graph.bin a log.txt
+ *
+ * Kazda stranka se zapise hned po prijeti: uzel do map.txt, zaznam do content.txt a vsechny jeji odkazy
+ * do docasneho souboru hran. Hrany vedouci na obchazene stranky se do map.txt pripisou az ve Finish,
+ * kdy je znama cela mnozina stranek; zaroven se zapise binarni graf (link_graph.h).
+ * Po padu tak v souborech zustanou vsechny dosud prijate stranky.
+ *
+ * writeWebGraph a writeContent zapisuji cely vysledek najednou z CResultStore (lokalni rezimy) - zaznamy formatuji
+ * paralelne po usecich (buffered_writer.h).
+ *
+ * Duplicitni stranky (aliasOf, duplicate_index.h) nejsou uzly grafu ani zaznamy content.txt - zapisou se
+ * do aliases.txt jako radek "alias puvodni" a odkazy na ne vedou na puvodni stranku.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "page_analysis.h"
+#include "link_graph.h"
+#include "buffered_writer.h"
+#include "result_store.h"
+
+class CResultWriter {
+	private:
+		std::string m_resultDir;
+
+		CBufferedFileWriter m_map;
+		CBufferedFileWriter m_content;
+		// dvojice radku "zdroj", "cil" pro vsechny nalezene odkazy v poradi zapisu stranek
+		CBufferedFileWriter m_edges;
+
+		// zapsane stranky a jejich index uzlu v grafu - pro odfiltrovani hran a duplicit
+		std::unordered_map<std::string, uint32_t> m_pages;
+		// duplicitni stranky -> puvodni stranka; aliases.txt se otevre az s prvnim aliasem
+		std::unordered_map<std::string, std::string> m_aliases;
+		std::unique_ptr<CBufferedFileWriter> m_aliasFile;
+		CLinkGraphBuilder m_graph;
+
+		bool m_finished{ false };
+
+	public:
+		// resultDir - existujici adresar, do ktereho se zapisuji soubory
+		explicit CResultWriter(const std::string& resultDir);
+		~CResultWriter();
+
+		// podarilo se otevrit vsechny soubory
+		bool Is_Open() const;
+
+		// zapise stranku (do bufferu souboru), duplicitu jen do aliases.txt; stranka se stejnou URL se zapise jen jednou.
+		// Vraci true, pokud byla stranka nova
+		bool Add_Page(const PageAnalysisResult& page);
+
+		// propise buffery na disk - volat po kazde prijate davce
+		void Flush();
+
+		size_t Pages() const { return m_pages.size(); }
+
+		// dopise do map.txt hrany mezi zapsanymi strankami, zapise graph.bin, smaze docasny soubor hran a zapise log.txt
+		void Finish(const std::string& startTime, const std::string& endTime);
+};
+
+// zapise map.txt (uzly v poradi stranek v ulozisti, pak hrany mezi nimi), graph.bin a pripadne aliases.txt;
+// threads - pocet formatovacich vlaken
+bool writeWebGraph(const std::string& resultDir, const CResultStore& store, size_t threads);
+
+// zapise content.txt - zaznamy stranek (bez duplicit) v poradi stranek v ulozisti
+bool writeContent(const std::string& resultDir, const CResultStore& store, size_t threads);
@@ -11,9 +11,107 @@
 #include <cassert>
 #include <iostream>
 #include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <optional>
+#include <cstdint>
 
 #include "server.h"
 #include "utils.h"
+#include "job_manager.h"
+
+namespace {
+	// radky vstupu jako seznam URL - bez prazdnych radku a bez '\r' (textarea posila CRLF)
+	std::vector<std::string> splitUrls(const std::string& input) {
+		std::vector<std::string> urls;
+		std::istringstream iss{ input };
+		std::string line;
+		while (std::getline(iss, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			if (!line.empty()) {
+				urls.push_back(line);
+			}
+		}
+		return urls;
+	}
+
+	std::string jsonEscape(const std::string& text) {
+		std::ostringstream oss;
+		for (unsigned char c : text) {
+			switch (c) {
+				case '"':
+					oss << "\\\"";
+					break;
+				case '\\':
+					oss << "\\\\";
+					break;
+				case '\n':
+					oss << "\\n";
+					break;
+				default:
+					if (c < 0x20) {
+						oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+					}
+					else {
+						oss << c;
+					}
+					break;
+			}
+		}
+		return oss.str();
+	}
+
+	std::string jobStatusJson(const JobStatus& status) {
+		std::ostringstream oss;
+		oss << "{\"id\":" << status.id
+			<< ",\"state\":\"" << jobStateName(status.state) << "\""
+			<< ",\"urls\":" << status.urlCount
+			<< ",\"queuePosition\":" << status.queuePosition
+			<< ",\"domainsDone\":" << status.progress.domainsDone
+			<< ",\"domainsTotal\":" << status.progress.domainsTotal
+			<< ",\"pagesDone\":" << status.progress.pagesDone
+			<< ",\"queueDepth\":" << status.progress.queueDepth
+			<< std::fixed << std::setprecision(1)
+			<< ",\"pagesPerSecond\":" << status.progress.pagesPerSecond
+			<< ",\"elapsedSeconds\":" << status.elapsedSeconds
+			<< ",\"error\":\"" << jsonEscape(status.error) << "\"}";
+		return oss.str();
+	}
+
+	std::string jsonError(const std::string& message) {
+		return "{\"error\":\"" + jsonEscape(message) + "\"}";
+	}
+
+	// radek s prubehem jobu vkladany do stranky s vysledky
+	std::string formatProgress(const JobStatus& status) {
+		std::ostringstream oss;
+		if (status.state == JobState::Queued) {
+			oss << "<div>Ceka ve fronte, poradi " << status.queuePosition << "</div>\n";
+			return oss.str();
+		}
+		oss << "<div>Prubeh: domeny " << status.progress.domainsDone << "/" << status.progress.domainsTotal
+			<< ", stranky " << status.progress.pagesDone
+			<< ", ve fronte " << status.progress.queueDepth
+			<< ", " << std::fixed << std::setprecision(1) << status.progress.pagesPerSecond << " stranek/s</div>\n";
+		return oss.str();
+	}
+
+	// id jobu z cesty /jobs/{id}...; vraci false pro neplatne cislo
+	bool parseJobId(const httplib::Request& req, uint64_t& id) {
+		if (req.matches.size() < 2) {
+			return false;
+		}
+		try {
+			id = std::stoull(req.matches[1].str());
+		}
+		catch (const std::exception&) {
+			return false;
+		}
+		return true;
+	}
+}
 
 CServer::CServer() : m_server{ std::make_unique<httplib::Server>() } {
 	// kontrola, zda byla instance vytvorena
@@ -25,6 +123,8 @@ CServer::~CServer() {
 	if (m_server && m_server->is_running()) {
 		m_server->stop();
 	}
+	// pocka na bezici job - pouziva m_onURLsReceived
+	m_jobs.reset();
 }
 
 bool CServer::Init(const std::string& basePath, const std::string& listenAddress, const int listenPort) {
@@ -75,10 +175,21 @@ bool CServer::Init(const std::string& basePath, const std::string& listenAddress
 
 	m_server->Get("/", std::bind(&CServer::Handle_Get_Any, this, std::placeholders::_1, std::placeholders::_2));
 	m_server->Post("/submit", static_cast<httplib::Server::Handler>(std::bind(&CServer::Handle_Post_Form, this, std::placeholders::_1, std::placeholders::_2)));
+	m_server->Post("/jobs", static_cast<httplib::Server::Handler>(std::bind(&CServer::Handle_Post_Job, this, std::placeholders::_1, std::placeholders::_2)));
+	m_server->Get(R"(/jobs/(\d+))", std::bind(&CServer::Handle_Get_Job, this, std::placeholders::_1, std::placeholders::_2));
+	m_server->Get(R"(/jobs/(\d+)/results)", std::bind(&CServer::Handle_Get_Job_Results, this, std::placeholders::_1, std::placeholders::_2));
+
+	// joby zpracovava callback registrovany pres RegisterFormCallback (muze se registrovat i po Init)
+	m_jobs = std::make_unique<CJobManager>([this](const std::vector<std::string>& urls, std::string& output) {
+		if (m_onURLsReceived) {
+			m_onURLsReceived(urls, output);
+		}
+	}, JobWorkers, JobQueueCapacity, MaxFinishedJobs);
 
 	m_server->set_error_handler([](const httplib::Request& req, httplib::Response& res) {
-		// pokud je status kod 500, uz jsme osetrili chybu jako vyjimku v handleru nize
-		if (res.status != 500) {
+		// pokud je status kod 500, uz jsme osetrili chybu jako vyjimku v handleru nize;
+		// odpovedi s vlastnim obsahem (napr. 400 nebo 503 z API jobu) nechavame, jak jsou
+		if (res.status != 500 && res.body.empty()) {
 			// pro jednoduchost povazujme vsechny ostatni chyby za 404
 			res.status = 404;
 			res.set_content("Stranka nebyla nalezena", "text/plain");
@@ -125,6 +236,18 @@ void CServer::Handle_Get_Any(const httplib::Request& req, httplib::Response& res
 	res.set_content(m_servedPage, "text/html");
 }
 
+std::string CServer::Render_Results(const std::string& content) const {
+	const std::string Placeholder{ VysledkyPlaceholder };
+
+	// nahradit vysledky do stranky results.html
+	std::string resultsPage = m_resultsPage;
+	size_t pos = resultsPage.find(Placeholder);
+	if (pos != std::string::npos) {
+		resultsPage.replace(pos, Placeholder.size(), content);
+	}
+	return resultsPage;
+}
+
 void CServer::Handle_Post_Form(const httplib::Request& req, httplib::Response& res) {
 	// zpracuje odeslany formular - kontrola parametru
 	if (!req.has_param("vstup")) {
@@ -133,35 +256,130 @@ void CServer::Handle_Post_Form(const httplib::Request& req, httplib::Response& r
 		return;
 	}
 
-	const std::string vstup = req.get_param_value("vstup");
+	const std::vector<std::string> urls = splitUrls(req.get_param_value("vstup"));
 
-	if (vstup.empty()) {
+	if (urls.empty()) {
 		res.status = 400;
 		res.set_content("Prazdny parametr 'vstup'", "text/plain");
 		return;
 	}
 
-	std::vector<std::string> lines;
-	std::istringstream iss{ vstup };
-	std::string line;
-	while (std::getline(iss, line)) {
-		lines.push_back(line);
+	// formular je jen klientem API jobu - vysledky (a prubeh) zobrazi /jobs/{id}/results
+	std::optional<uint64_t> id = m_jobs->Submit(urls);
+	if (!id) {
+		res.status = 503;
+		res.set_header("Retry-After", "5");
+		res.set_content("Server je pretizen, zkuste to prosim pozdeji", "text/plain");
+		return;
 	}
 
-	std::string vystup;
+	res.set_redirect("/jobs/" + std::to_string(*id) + "/results", 303);
+}
+
+void CServer::Handle_Post_Job(const httplib::Request& req, httplib::Response& res) {
+	const std::vector<std::string> urls = splitUrls(req.has_param("vstup") ? req.get_param_value("vstup") : req.body);
 
-	if (m_onURLsReceived) {
-		m_onURLsReceived(lines, vystup);
+	if (urls.empty()) {
+		res.status = 400;
+		res.set_content(jsonError("Zadne URL ke zpracovani"), "application/json");
+		return;
 	}
 
-	const std::string Placeholder{ VysledkyPlaceholder };
+	// kontrola pristupu - plna fronta se odmitne hned, klient to muze zkusit pozdeji
+	std::optional<uint64_t> id = m_jobs->Submit(urls);
+	if (!id) {
+		res.status = 503;
+		res.set_header("Retry-After", "5");
+		res.set_content(jsonError("Fronta jobu je plna"), "application/json");
+		return;
+	}
 
-	// nahradit vysledky do stranky results.html
-	std::string resultsPage = m_resultsPage;
-	size_t pos = resultsPage.find(Placeholder);
+	JobStatus status;
+	if (!m_jobs->Get_Status(*id, status)) {
+		status.id = *id;
+	}
+
+	res.status = 202;
+	res.set_header("Location", "/jobs/" + std::to_string(*id));
+	res.set_content(jobStatusJson(status), "application/json");
+}
+
+void CServer::Handle_Get_Job(const httplib::Request& req, httplib::Response& res) {
+	uint64_t id;
+	JobStatus status;
+	if (!parseJobId(req, id) || !m_jobs->Get_Status(id, status)) {
+		res.status = 404;
+		res.set_content(jsonError("Neznamy job"), "application/json");
+		return;
+	}
+
+	res.set_content(jobStatusJson(status), "application/json");
+}
+
+void CServer::Handle_Get_Job_Results(const httplib::Request& req, httplib::Response& res) {
+	uint64_t id;
+	JobStatus status;
+	if (!parseJobId(req, id) || !m_jobs->Get_Status(id, status)) {
+		res.status = 404;
+		res.set_content("Neznamy job", "text/plain");
+		return;
+	}
+
+	// hotovy job - cela stranka najednou
+	if (status.state == JobState::Done || status.state == JobState::Failed) {
+		std::string output;
+		if (status.state == JobState::Failed || !m_jobs->Get_Output(id, output)) {
+			res.status = 500;
+			output = status.error;
+		}
+		res.set_content(Render_Results(output), "text/html");
+		return;
+	}
+
+	// stranka s vysledky rozdelena v miste pro vysledky
+	const std::string Placeholder{ VysledkyPlaceholder };
+	std::string head = m_resultsPage;
+	std::string tail;
+	size_t pos = m_resultsPage.find(Placeholder);
 	if (pos != std::string::npos) {
-		resultsPage.replace(pos, Placeholder.size(), vystup);
+		head = m_resultsPage.substr(0, pos);
+		tail = m_resultsPage.substr(pos + Placeholder.size());
 	}
 
-	res.set_content(resultsPage, "text/html");
+	// httplib vola poskytovatele opakovane, dokud nezavola sink.done(); kazde volani ceka nejvyse ProgressInterval.
+	// Odpojeni klienta job neovlivni - vysledky zustanou dostupne pres API
+	auto headSent = std::make_shared<bool>(false);
+	res.set_chunked_content_provider("text/html",
+		[this, id, headSent, head = std::move(head), tail = std::move(tail)](size_t /*offset*/, httplib::DataSink& sink) {
+			if (!*headSent) {
+				*headSent = true;
+				return sink.write(head.data(), head.size());
+			}
+
+			bool finished = m_jobs->Wait_Finished(id, ProgressInterval);
+
+			JobStatus current;
+			if (!m_jobs->Get_Status(id, current)) {
+				std::string rest = "Vysledky jobu uz nejsou k dispozici" + tail;
+				sink.write(rest.data(), rest.size());
+				sink.done();
+				return true;
+			}
+
+			if (!finished) {
+				std::string line = formatProgress(current);
+				return sink.write(line.data(), line.size());
+			}
+
+			std::string output;
+			if (current.state != JobState::Done || !m_jobs->Get_Output(id, output)) {
+				output = current.error;
+			}
+			std::string rest = output + tail;
+			if (!sink.write(rest.data(), rest.size())) {
+				return false;
+			}
+			sink.done();
+			return true;
+		});
 }
@@ -8,6 +8,9 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <vector>
+#include <chrono>
+#include <cstddef>
 
 // dopredne deklarace
 namespace httplib {
@@ -15,6 +18,7 @@ namespace httplib {
 	struct Request;
 	struct Response;
 }
+class CJobManager;
 
 // server obstaravajici prijimani pozadavku
 class CServer {
@@ -27,6 +31,16 @@ class CServer {
 		// placeholder pro vysledky
 		static constexpr const char* VysledkyPlaceholder = "<!-- VYSLEDKY -->";
 
+		// jak casto se behem obchodu posila klientovi radek s prubehem
+		static constexpr std::chrono::milliseconds ProgressInterval{ 1000 };
+
+		// pocet soubezne bezicich jobu - MPI master zvladne jen jeden obchod najednou
+		static constexpr size_t JobWorkers = 1;
+		// kolik jobu muze cekat ve fronte; dalsi se odmitnou (503)
+		static constexpr size_t JobQueueCapacity = 16;
+		// kolik dokoncenych jobu si server pamatuje (vcetne vystupu)
+		static constexpr size_t MaxFinishedJobs = 64;
+
 	private:
 		// HTML kod stranky, kterou bude server poskytovat
 		std::string m_servedPage;
@@ -45,12 +59,26 @@ class CServer {
 		// callback pro zpracovani odeslanych URL
 		std::function<void(const std::vector<std::string>&, std::string&)> m_onURLsReceived;
 
+		// joby obchodu; vytvari se v Init, zpracovava je m_onURLsReceived
+		std::unique_ptr<CJobManager> m_jobs;
+
+		// stranka s vysledky, kde je misto pro vysledky nahrazeno content
+		std::string Render_Results(const std::string& content) const;
+
 	protected:
 		// obsluha GET pozadavku na hlavni stranku
 		void Handle_Get_Any(const httplib::Request& req, httplib::Response& res);
-		// obsluha POST pozadavku z formulare
+		// obsluha POST pozadavku z formulare - jen zalozi job a presmeruje na /jobs/{id}/results
 		void Handle_Post_Form(const httplib::Request& req, httplib::Response& res);
 
+		// POST /jobs - zalozi job (URL v parametru "vstup" nebo v tele, po radcich); 202 s id, 503 pri plne fronte
+		void Handle_Post_Job(const httplib::Request& req, httplib::Response& res);
+		// GET /jobs/{id} - stav a citace jobu (JSON)
+		void Handle_Get_Job(const httplib::Request& req, httplib::Response& res);
+		// GET /jobs/{id}/results - stranka s vysledky; dokud job bezi, posila se po castech (chunked):
+		// zacatek hned, kazdou ProgressInterval radek s prubehem, na konci vysledky
+		void Handle_Get_Job_Results(const httplib::Request& req, httplib::Response& res);
+
 	public:
 		// konstruktor
 		explicit CServer();
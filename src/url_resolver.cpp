@@ -0,0 +1,302 @@
+/**
+ * Rozklad URL na slozky a reseni relativnich odkazu podle RFC 3986 bez regularnich vyrazu a bez alokaci
+ */
+
+#include "url_resolver.h"
+
+namespace {
+
+    constexpr size_t npos = std::string_view::npos;
+
+    char toLowerAscii(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+
+    bool isAlpha(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    bool isSchemeChar(char c) {
+        return isAlpha(c) || (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.';
+    }
+
+    bool isHtmlSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+    }
+
+    bool equalsCi(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++) {
+            if (toLowerAscii(a[i]) != toLowerAscii(b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // prohlizece odstranuji z hodnoty href bile znaky na zacatku a na konci
+    std::string_view trimHtmlSpace(std::string_view s) {
+        while (!s.empty() && isHtmlSpace(s.front())) {
+            s.remove_prefix(1);
+        }
+        while (!s.empty() && isHtmlSpace(s.back())) {
+            s.remove_suffix(1);
+        }
+        return s;
+    }
+
+    bool isHttpScheme(std::string_view scheme) {
+        return equalsCi(scheme, "http") || equalsCi(scheme, "https");
+    }
+
+    // authority bez vychoziho portu schematu (a bez prazdneho portu "host:")
+    std::string_view stripDefaultPort(std::string_view scheme, std::string_view authority) {
+        size_t colon = authority.rfind(':');
+        // ':' uvnitr IPv6 literalu [..] neni oddelovac portu
+        if (colon == npos || authority.find(']', colon) != npos) {
+            return authority;
+        }
+        std::string_view port = authority.substr(colon + 1);
+        if (port.empty() || (equalsCi(scheme, "http") && port == "80") || (equalsCi(scheme, "https") && port == "443")) {
+            return authority.substr(0, colon);
+        }
+        return authority;
+    }
+
+    void appendLower(std::string& out, std::string_view s) {
+        for (char c : s) {
+            out.push_back(toLowerAscii(c));
+        }
+    }
+
+    // odstrani segmenty "." a ".." (RFC 3986, 5.2.4) z casti out od pathStart dal; pracuje na miste
+    void removeDotSegments(std::string& out, size_t pathStart) {
+        size_t end = out.size();
+        size_t r = pathStart;
+        size_t w = pathStart;
+
+        while (r < end) {
+            // cesta za authority vzdy zacina '/', kazdy segment tedy take
+            size_t segStart = r + 1;
+            size_t segEnd = out.find('/', segStart);
+            if (segEnd == std::string::npos || segEnd > end) {
+                segEnd = end;
+            }
+            std::string_view segment(out.data() + segStart, segEnd - segStart);
+            bool isLast = (segEnd == end);
+
+            if (segment == ".") {
+                if (isLast) {
+                    out[w++] = '/';
+                }
+            }
+            else if (segment == "..") {
+                // vrati se pred posledni zapsany segment
+                while (w > pathStart && out[w - 1] != '/') {
+                    w--;
+                }
+                if (w > pathStart) {
+                    w--;
+                }
+                if (isLast) {
+                    out[w++] = '/';
+                }
+            }
+            else {
+                // w <= r, kopirovani smerem dopredu je bezpecne
+                for (size_t i = r; i < segEnd; i++) {
+                    out[w++] = out[i];
+                }
+            }
+            r = segEnd;
+        }
+
+        out.resize(w);
+    }
+}
+
+UrlParts parseUrl(std::string_view url) {
+    UrlParts parts;
+
+    // schema: ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ) ":"
+    if (!url.empty() && isAlpha(url[0])) {
+        size_t i = 1;
+        while (i < url.size() && isSchemeChar(url[i])) {
+            i++;
+        }
+        if (i < url.size() && url[i] == ':') {
+            parts.scheme = url.substr(0, i);
+            parts.hasScheme = true;
+            url.remove_prefix(i + 1);
+        }
+    }
+
+    size_t hash = url.find('#');
+    if (hash != npos) {
+        parts.fragment = url.substr(hash + 1);
+        parts.hasFragment = true;
+        url = url.substr(0, hash);
+    }
+
+    size_t question = url.find('?');
+    if (question != npos) {
+        parts.query = url.substr(question + 1);
+        parts.hasQuery = true;
+        url = url.substr(0, question);
+    }
+
+    if (url.size() >= 2 && url[0] == '/' && url[1] == '/') {
+        size_t pathStart = url.find('/', 2);
+        parts.authority = url.substr(2, pathStart == npos ? npos : pathStart - 2);
+        parts.hasAuthority = true;
+        url = (pathStart == npos) ? std::string_view() : url.substr(pathStart);
+    }
+
+    parts.path = url;
+    return parts;
+}
+
+bool resolveUrl(std::string_view base, std::string_view reference, std::string& out) {
+    out.clear();
+
+    UrlParts b = parseUrl(base);
+    if (!b.hasScheme || !b.hasAuthority || !isHttpScheme(b.scheme)) {
+        return false;
+    }
+
+    UrlParts r = parseUrl(trimHtmlSpace(reference));
+
+    std::string_view scheme = b.scheme;
+    std::string_view authority = b.authority;
+    std::string_view query = r.query;
+    bool hasQuery = r.hasQuery;
+
+    // cesta se sklada nejvyse ze dvou casti: adresare zakladni URL a cesty odkazu
+    std::string_view pathPrefix;
+    std::string_view path = r.path;
+
+    if (r.hasScheme) {
+        if (!isHttpScheme(r.scheme) || !r.hasAuthority) {
+            return false;
+        }
+        scheme = r.scheme;
+        authority = r.authority;
+    }
+    else if (r.hasAuthority) {
+        authority = r.authority;
+    }
+    else if (r.path.empty()) {
+        path = b.path;
+        if (!r.hasQuery) {
+            query = b.query;
+            hasQuery = b.hasQuery;
+        }
+    }
+    else if (r.path[0] != '/') {
+        // merge (RFC 3986, 5.2.3): adresar zakladni URL vcetne posledniho '/'
+        size_t lastSlash = b.path.rfind('/');
+        pathPrefix = (lastSlash == npos) ? std::string_view("/") : b.path.substr(0, lastSlash + 1);
+    }
+
+    appendLower(out, scheme);
+    out += "://";
+    appendLower(out, stripDefaultPort(scheme, authority));
+
+    size_t pathStart = out.size();
+    if (pathPrefix.empty() && (path.empty() || path[0] != '/')) {
+        out += '/';
+    }
+    out += pathPrefix;
+    out += path;
+    removeDotSegments(out, pathStart);
+    if (out.size() == pathStart) {
+        out += '/';
+    }
+
+    if (hasQuery) {
+        out += '?';
+        out += query;
+    }
+
+    return true;
+}
+
+std::string getBaseUrl(const std::string& url) {
+    UrlParts parts = parseUrl(url);
+    if (!parts.hasScheme || !parts.hasAuthority || !isHttpScheme(parts.scheme) || parts.authority.empty()) {
+        return url;
+    }
+
+    std::string result;
+    result.reserve(url.size());
+    appendLower(result, parts.scheme);
+    result += "://";
+    appendLower(result, stripDefaultPort(parts.scheme, parts.authority));
+
+    // prvni neprazdny segment cesty
+    if (parts.path.size() > 1) {
+        size_t segmentEnd = parts.path.find('/', 1);
+        result += parts.path.substr(0, segmentEnd);
+    }
+
+    return result;
+}
+
+std::string getOrigin(const std::string& url) {
+    UrlParts parts = parseUrl(url);
+    if (!parts.hasScheme || !parts.hasAuthority || !isHttpScheme(parts.scheme) || parts.authority.empty()) {
+        return "";
+    }
+
+    std::string result;
+    appendLower(result, parts.scheme);
+    result += "://";
+    appendLower(result, stripDefaultPort(parts.scheme, parts.authority));
+    return result;
+}
+
+std::string normalizeUrl(const std::string& baseUrl, const std::string& url) {
+    std::string result;
+    if (url.empty() || !resolveUrl(baseUrl, url, result)) {
+        return "";
+    }
+    return result;
+}
+
+bool isSameDomain(const std::string& baseUrl, const std::string& url) {
+    UrlParts base = parseUrl(baseUrl);
+    UrlParts target = parseUrl(url);
+
+    if (!base.hasScheme || !target.hasScheme || !base.hasAuthority || !target.hasAuthority) {
+        // neni co rozlozit - puvodni porovnani prefixu
+        return url.find(baseUrl) == 0;
+    }
+
+    if (!equalsCi(base.scheme, target.scheme)
+        || !equalsCi(stripDefaultPort(base.scheme, base.authority), stripDefaultPort(target.scheme, target.authority))) {
+        return false;
+    }
+
+    return target.path.substr(0, base.path.size()) == base.path;
+}
+
+std::string urlToSafeFilename(const std::string& url) {
+    std::string result = url;
+
+    // Видаляємо протокол
+    size_t protocolPos = result.find("://");
+    if (protocolPos != std::string::npos) {
+        result = result.substr(protocolPos + 3);
+    }
+
+    // Заміняємо небезпечні символи на підкреслення
+    for (char& c : result) {
+        if (c == '/' || c == ':' || c == '.' || c == '?' || c == '&' || c == '=' || c == ' ' || c == '#') {
+            c = '_';
+        }
+    }
+
+    return result;
+}
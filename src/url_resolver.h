@@ -0,0 +1,46 @@
+/**
+ * Rozklad URL na slozky a reseni relativnich odkazu podle RFC 3986 bez regularnich vyrazu a bez alokaci
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// slozky URL podle RFC 3986, dodatek B; vsechny pohledy ukazuji do puvodniho retezce
+struct UrlParts {
+    std::string_view scheme;     // bez ':'
+    std::string_view authority;  // bez uvodniho "//"
+    std::string_view path;
+    std::string_view query;      // bez '?'
+    std::string_view fragment;   // bez '#'
+    bool hasScheme = false;
+    bool hasAuthority = false;
+    bool hasQuery = false;
+    bool hasFragment = false;
+};
+
+// rozlozi URL nebo relativni odkaz na slozky; nikdy neselze (kazdy retezec je platny odkaz)
+UrlParts parseUrl(std::string_view url);
+
+// vyresi odkaz reference vuci absolutni URL base (RFC 3986, 5.2) a zapise normalizovany vysledek do out:
+// schema a host malymi pismeny, bez vychoziho portu, bez segmentu "." a "..", prazdna cesta jako "/", bez fragmentu.
+// out se pred zapisem vyprazdni, jeho kapacita se znovu pouzije.
+// vraci false (a prazdny out), pokud base neni absolutni http(s) URL nebo vysledek neni http(s) URL (mailto:, javascript: ...)
+bool resolveUrl(std::string_view base, std::string_view reference, std::string& out);
+
+// schema a host (bez vychoziho portu) malymi pismeny, napr. "https://example.com" - klic hostitele pro rizeni zateze;
+// pro URL, ktera neni absolutni http(s) URL, vraci prazdny retezec
+std::string getOrigin(const std::string& url);
+
+// Виокремлення базового URL (схема, хост і перший сегмент шляху) - межа, в якій краулер залишається
+std::string getBaseUrl(const std::string& url);
+
+// Нормалізація URL відносно базового URL; повертає порожній рядок, якщо посилання не веде на http(s) сторінку
+std::string normalizeUrl(const std::string& baseUrl, const std::string& url);
+
+// Функція для перевірки чи URL належить до тієї ж домену і шляху (схема і хост без урахування регістру)
+bool isSameDomain(const std::string& baseUrl, const std::string& url);
+
+// Функція для безпечного перетворення URL в назву файлу (без схеми, символи / : . ? & = пробіл # замінені на '_')
+std::string urlToSafeFilename(const std::string& url);
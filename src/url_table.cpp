@@ -0,0 +1,131 @@
+/**
+ * Tabulka internovanych URL - kazda URL je ulozena jednou v arene bajtu a ma 32bitove ID
+ */
+
+#include "url_table.h"
+
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+namespace {
+	// index se zvetsuje pri zaplneni nad 70 %
+	constexpr size_t MaxLoadPercent = 70;
+	constexpr size_t MinSlots = 16;
+}
+
+CUrlTable::CUrlTable(size_t expectedUrls) {
+	size_t slots = MinSlots;
+	while (slots * MaxLoadPercent / 100 < expectedUrls) {
+		slots *= 2;
+	}
+	m_slots.assign(slots, 0);
+
+	m_locations.reserve(expectedUrls);
+	m_lengths.reserve(expectedUrls);
+	m_hashes.reserve(expectedUrls);
+}
+
+uint32_t CUrlTable::Hash(std::string_view url) {
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (char c : url) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+size_t CUrlTable::Find_Slot(std::string_view url, uint32_t hash) const {
+	size_t mask = m_slots.size() - 1;
+	for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+		uint32_t entry = m_slots[slot];
+		if (entry == 0) {
+			return slot;
+		}
+		UrlId id = entry - 1;
+		if (m_hashes[id] == hash && View(id) == url) {
+			return slot;
+		}
+	}
+}
+
+void CUrlTable::Grow() {
+	std::vector<uint32_t> slots(m_slots.size() * 2, 0);
+	size_t mask = slots.size() - 1;
+
+	for (UrlId id = 0; id < m_hashes.size(); id++) {
+		size_t slot = m_hashes[id] & mask;
+		while (slots[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		slots[slot] = id + 1;
+	}
+
+	m_slots = std::move(slots);
+}
+
+uint32_t CUrlTable::Store(std::string_view url) {
+	constexpr size_t MaxChunks = size_t{ 1 } << (32 - ChunkBits);
+
+	// URL se nikdy nerozdeluje mezi dva bloky; pokud se do aktualniho nevejde, zacne se novy.
+	// Zaplneny blok (i na zacatku, kdy zadny neni) se vymeni i pro prazdny retezec - posun ChunkSize
+	// by se v umisteni prepsal do indexu bloku
+	if (m_chunkUsed == ChunkSize || url.size() > ChunkSize - m_chunkUsed) {
+		if (m_chunks.size() >= MaxChunks) {
+			throw std::length_error("CUrlTable: prekrocena maximalni velikost areny");
+		}
+		size_t chunkSize = std::max<size_t>(ChunkSize, url.size());
+		m_chunks.push_back(std::make_unique<char[]>(chunkSize));
+		m_arenaBytes += chunkSize;
+		m_chunkUsed = 0;
+	}
+
+	uint32_t location = (static_cast<uint32_t>(m_chunks.size() - 1) << ChunkBits) | m_chunkUsed;
+	std::copy(url.begin(), url.end(), m_chunks.back().get() + m_chunkUsed);
+	// nadrozmerna URL zaplni svuj blok cely
+	m_chunkUsed = (url.size() >= ChunkSize) ? ChunkSize : m_chunkUsed + static_cast<uint32_t>(url.size());
+
+	return location;
+}
+
+std::pair<UrlId, bool> CUrlTable::Intern(std::string_view url) {
+	uint32_t hash = Hash(url);
+	size_t slot = Find_Slot(url, hash);
+	if (m_slots[slot] != 0) {
+		return { m_slots[slot] - 1, false };
+	}
+
+	if (m_hashes.size() + 1 >= std::numeric_limits<UrlId>::max() || url.size() > std::numeric_limits<uint32_t>::max()) {
+		throw std::length_error("CUrlTable: prekrocena maximalni velikost tabulky");
+	}
+
+	UrlId id = static_cast<UrlId>(m_hashes.size());
+	m_locations.push_back(Store(url));
+	m_lengths.push_back(static_cast<uint32_t>(url.size()));
+	m_hashes.push_back(hash);
+	m_slots[slot] = id + 1;
+
+	if (m_hashes.size() * 100 > m_slots.size() * MaxLoadPercent) {
+		Grow();
+	}
+
+	return { id, true };
+}
+
+std::optional<UrlId> CUrlTable::Find(std::string_view url) const {
+	size_t slot = Find_Slot(url, Hash(url));
+	if (m_slots[slot] == 0) {
+		return std::nullopt;
+	}
+	return m_slots[slot] - 1;
+}
+
+size_t CUrlTable::Memory_Usage() const {
+	return m_arenaBytes
+		+ m_chunks.capacity() * sizeof(std::unique_ptr<char[]>)
+		+ m_locations.capacity() * sizeof(uint32_t)
+		+ m_lengths.capacity() * sizeof(uint32_t)
+		+ m_hashes.capacity() * sizeof(uint32_t)
+		+ m_slots.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,77 @@
+/**
+ * Tabulka internovanych URL - kazda URL je ulozena jednou v arene bajtu a ma 32bitove ID
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// identifikator URL v CUrlTable; ID jsou prideleny postupne od 0
+using UrlId = uint32_t;
+
+class CUrlTable {
+	private:
+		// velikost jednoho bloku areny; delsi URL dostane vlastni blok
+		static constexpr unsigned ChunkBits = 20;
+		static constexpr uint32_t ChunkSize = 1u << ChunkBits;
+
+		// URL jsou ulozeny za sebou bez oddelovacu v blocich pevne velikosti - pri rustu se nic nekopiruje
+		// a na rozdil od zdvojovani std::vector nezustava nevyuzita kapacita
+		std::vector<std::unique_ptr<char[]>> m_chunks;
+		uint32_t m_chunkUsed{ ChunkSize };
+		size_t m_arenaBytes{ 0 };
+		// umisteni URL s danym ID: index bloku v hornich bitech, posun v bloku v dolnich ChunkBits bitech
+		std::vector<uint32_t> m_locations;
+		std::vector<uint32_t> m_lengths;
+		// hash kazde URL, aby se pri zvetsovani indexu nemusel pocitat znovu
+		std::vector<uint32_t> m_hashes;
+		// otevrene adresovani s linearnim prohledavanim, hodnota je ID + 1 (0 = prazdny slot)
+		std::vector<uint32_t> m_slots;
+
+		// zkopiruje text URL do areny a vrati jeho umisteni
+		uint32_t Store(std::string_view url);
+
+		static uint32_t Hash(std::string_view url);
+
+		// najde slot s danou URL nebo prvni prazdny slot, kam by patrila
+		size_t Find_Slot(std::string_view url, uint32_t hash) const;
+
+		void Grow();
+
+	public:
+		explicit CUrlTable(size_t expectedUrls = 0);
+
+		// vrati ID URL a true, pokud byla URL nove vlozena (tzn. dosud nenavstivena)
+		std::pair<UrlId, bool> Intern(std::string_view url);
+
+		// vrati ID URL, pokud je v tabulce
+		std::optional<UrlId> Find(std::string_view url) const;
+
+		bool Contains(std::string_view url) const {
+			return Find(url).has_value();
+		}
+
+		// pohled na text URL; plati po celou dobu zivota tabulky
+		std::string_view View(UrlId id) const {
+			uint32_t location = m_locations[id];
+			return std::string_view(m_chunks[location >> ChunkBits].get() + (location & (ChunkSize - 1)), m_lengths[id]);
+		}
+
+		std::string Materialize(UrlId id) const {
+			return std::string(View(id));
+		}
+
+		size_t Size() const {
+			return m_hashes.size();
+		}
+
+		// pocet bajtu alokovanych tabulkou (arena + indexy)
+		size_t Memory_Usage() const;
+};
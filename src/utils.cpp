@@ -9,9 +9,25 @@
 #include "../dep/cpp-httplib/httplib.h"
 
 #include "utils.h"
+#include "connection_pool.h"
+
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
 
 namespace utils {
 
+	namespace {
+		// text/html a XHTML; parametry (charset) a velikost pismen se ignoruji
+		bool isHtmlContentType(const std::string& contentType) {
+			std::string type = contentType.substr(0, contentType.find(';'));
+			std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			type.erase(0, type.find_first_not_of(" \t"));
+			type.erase(type.find_last_not_of(" \t") + 1);
+			return type == "text/html" || type == "application/xhtml+xml";
+		}
+	}
+
 	std::string readWholeFile(const std::string& path) {
 		// otevreni souboru
 		std::ifstream ifs(path);
@@ -25,6 +41,11 @@ namespace utils {
 	}
 
 	std::string downloadHTML(const std::string& url) {
+		HttpPage page = downloadPage(url, "", "");
+		return page.status == 200 ? std::move(page.body) : "";
+	}
+
+	HttpPage downloadPage(const std::string& url, const std::string& etag, const std::string& lastModified, const BodySink* sink) {
 
 		std::string scheme;
 		std::string rest;
@@ -39,31 +60,88 @@ namespace utils {
 			rest = url.substr(8);
 		}
 		else {
-			return ""; // nezname schema
+			return {}; // nezname schema
 		}
 
 		size_t pos = rest.find("/");
 		std::string domain = rest.substr(0, pos);
 		std::string path = rest.substr(pos);
 
-		// stahne obsah stranky - pouzije SSL klienta, pokud je pozadovana podpora SSL
-#ifdef USE_SSL
-		httplib::SSLClient cli(domain.c_str());
-		cli.enable_server_certificate_verification(false);
-		cli.enable_server_hostname_verification(false);
-#else
-		httplib::Client cli(domain.c_str());
-#endif
+		// validatory z predchozi navstevy - server odpovi 304, pokud se stranka nezmenila
+		httplib::Headers headers;
+		if (!etag.empty()) {
+			headers.emplace("If-None-Match", etag);
+		}
+		if (!lastModified.empty()) {
+			headers.emplace("If-Modified-Since", lastModified);
+		}
 
-		cli.set_follow_location(true);
-		auto res = cli.Get(path.c_str());
+		// stahne obsah stranky - klienta (SSL, pokud je pozadovana podpora SSL) si pujcime z poolu,
+		// aby se keep-alive spojeni k temuz hostu znovu pouzilo
+		CConnectionPool& pool = CConnectionPool::Instance();
+		std::unique_ptr<HttpClient> cli = pool.Acquire(scheme, domain);
 
-		if (!res || res->status != 200) {
-			std::cerr << "Chyba: " << res->status << std::endl;
-			return "";
+		// hlavicky se zpracuji pred telem - podle nich se prenos muze prerusit hned na zacatku;
+		// presmerovani (follow_location) sem nedojdou, jen konecna odpoved
+		HttpPage page;
+		bool receiving = false;
+		// prijate bajty tela pro limit maxBytes - s onChunk se telo do page.body neuklada
+		size_t received = 0;
+		auto onResponse = [&](const httplib::Response& response) {
+			page.status = response.status;
+			if (response.status == 429 || response.status == 503) {
+				page.retryAfter = std::atoi(response.get_header_value("Retry-After").c_str());
+			}
+			if (response.status != 200 && response.status != 304) {
+				return true;
+			}
+			page.etag = response.get_header_value("ETag");
+			page.lastModified = response.get_header_value("Last-Modified");
+			if (response.status == 200 && sink && sink->htmlOnly && response.has_header("Content-Type")
+				&& !isHtmlContentType(response.get_header_value("Content-Type"))) {
+				page.notHtml = true;
+				return false;
+			}
+			receiving = response.status == 200;
+			return true;
+		};
+		auto onContent = [&](const char* data, size_t length) {
+			// telo chybove odpovedi se nepouziva
+			if (!receiving) {
+				return true;
+			}
+			if (sink && sink->maxBytes > 0 && received + length > sink->maxBytes) {
+				length = sink->maxBytes - received;
+				page.truncated = true;
+			}
+			received += length;
+			if (sink && sink->onChunk) {
+				if (length > 0) {
+					sink->onChunk(std::string_view(data, length));
+				}
+			} else {
+				page.body.append(data, length);
+			}
+			return !page.truncated;
+		};
+
+		auto res = cli->Get(path.c_str(), headers, onResponse, onContent);
+
+		if (!res) {
+			// spojeni je v neznamem stavu (u prerusene odpovedi zbyva neprectene telo), klient se do poolu nevraci
+			if (page.notHtml || page.truncated) {
+				return page;
+			}
+			std::cerr << "Chyba: " << httplib::to_string(res.error()) << std::endl;
+			return {};
 		}
 
-		return res->body;
+		pool.Release(scheme, domain, std::move(cli));
+
+		if (page.status != 200 && page.status != 304) {
+			std::cerr << "Chyba: " << page.status << std::endl;
+		}
+		return page;
 	}
 
 }
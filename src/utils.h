@@ -6,8 +6,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <fstream>
+#include <functional>
+#include <cstddef>
 
 namespace utils {
 	// precte cely soubor do retezce
@@ -19,4 +22,37 @@ namespace utils {
 	// url - adresa stranky
 	// vraci obsah stranky nebo prazdny retezec v pripade chyby
 	std::string downloadHTML(const std::string& url);
+
+	// odpoved na (podmineny) GET
+	struct HttpPage {
+		// HTTP status; 0 = chyba spojeni nebo nezname schema
+		int status = 0;
+		// prazdne, pokud telo prevzal BodySink::onChunk
+		std::string body;
+		// validatory odpovedi (hlavicky ETag a Last-Modified), prazdne, pokud je server neposlal
+		std::string etag;
+		std::string lastModified;
+		// Retry-After odpovedi 429/503 v sekundach; 0 = server ho neposlal (nebo ho poslal jako datum)
+		int retryAfter = 0;
+		// prenos odpovedi 200 prerusen po hlavickach, protoze Content-Type neni HTML (body je prazdne)
+		bool notHtml = false;
+		// prenos odpovedi 200 prerusen po BodySink::maxBytes - prijat je jen zacatek stranky
+		bool truncated = false;
+	};
+
+	// prubezne zpracovani tela odpovedi 200 behem stahovani
+	struct BodySink {
+		// delsi telo se po maxBytes prerusi; 0 = bez omezeni
+		size_t maxBytes = 0;
+		// odpoved s Content-Type jinym nez HTML se prerusi hned po hlavickach (odpoved bez Content-Type se stahne)
+		bool htmlOnly = false;
+		// dalsi kus tela v poradi prijeti, vola se ve vlakne downloadPage
+		std::function<void(std::string_view chunk)> onChunk;
+	};
+
+	// stahne stranku z dane URL; neprazdne etag/lastModified se poslou jako If-None-Match/If-Modified-Since
+	// a nezmenena stranka pak vrati status 304 bez obsahu. S sink se telo odpovedi 200 predava po kusech uz behem
+	// stahovani a prenos se muze predcasne prerusit (HttpPage::notHtml, HttpPage::truncated). Body obsahuje vse prijate,
+	// jen pokud sink nema onChunk - jinak telo drzi jen jeho prijemce a neuklada se dvakrat
+	HttpPage downloadPage(const std::string& url, const std::string& etag, const std::string& lastModified, const BodySink* sink = nullptr);
 }
@@ -0,0 +1,160 @@
+/**
+ * Kompaktni mnozina navstivenych URL - uklada jen 64bitove otisky URL, volitelne s Bloomovym filtrem pred tabulkou
+ */
+
+#include "visited_set.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+	// tabulka se zvetsuje pri zaplneni nad 75 %
+	constexpr size_t MaxLoadPercent = 75;
+	constexpr size_t MinSlots = 16;
+
+	// finalizer z MurmurHash3 - rozprostre bity FNV hashe
+	uint64_t mix64(uint64_t x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return x;
+	}
+}
+
+CFingerprintSet::CFingerprintSet(const Config& config) {
+	size_t slots = MinSlots;
+	while (slots * MaxLoadPercent / 100 < config.expectedUrls) {
+		slots *= 2;
+	}
+	m_slots.assign(slots, 0);
+
+	if (config.useBloomFilter) {
+		// optimalni velikost m = -n ln p / (ln 2)^2 a pocet hashu k = m/n ln 2
+		double n = static_cast<double>(std::max<size_t>(config.expectedUrls, 1));
+		double p = std::clamp(config.bloomFalsePositiveRate, 1e-9, 0.5);
+		double ln2 = std::log(2.0);
+		m_bloomBitCount = std::max<size_t>(64, static_cast<size_t>(std::ceil(-n * std::log(p) / (ln2 * ln2))));
+		m_bloomHashes = std::max(1u, static_cast<unsigned>(std::round(m_bloomBitCount / n * ln2)));
+		m_bloomBits.assign((m_bloomBitCount + 63) / 64, 0);
+	}
+}
+
+uint64_t CFingerprintSet::Fingerprint(std::string_view url) {
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for (char c : url) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+	hash = mix64(hash);
+	return hash == 0 ? 1 : hash;
+}
+
+bool CFingerprintSet::Bloom_Maybe_Contains(uint64_t fingerprint) const {
+	// dvojite hashovani (Kirsch-Mitzenmacher) z horni a dolni poloviny otisku
+	uint64_t h1 = fingerprint & 0xffffffffULL;
+	uint64_t h2 = (fingerprint >> 32) | 1;
+	for (unsigned i = 0; i < m_bloomHashes; i++) {
+		size_t bit = (h1 + i * h2) % m_bloomBitCount;
+		if ((m_bloomBits[bit / 64] & (1ULL << (bit % 64))) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void CFingerprintSet::Bloom_Add(uint64_t fingerprint) {
+	uint64_t h1 = fingerprint & 0xffffffffULL;
+	uint64_t h2 = (fingerprint >> 32) | 1;
+	for (unsigned i = 0; i < m_bloomHashes; i++) {
+		size_t bit = (h1 + i * h2) % m_bloomBitCount;
+		m_bloomBits[bit / 64] |= 1ULL << (bit % 64);
+	}
+}
+
+size_t CFingerprintSet::Find_Slot(uint64_t fingerprint) const {
+	size_t mask = m_slots.size() - 1;
+	for (size_t slot = fingerprint & mask;; slot = (slot + 1) & mask) {
+		if (m_slots[slot] == 0 || m_slots[slot] == fingerprint) {
+			return slot;
+		}
+	}
+}
+
+void CFingerprintSet::Grow() {
+	std::vector<uint64_t> old = std::move(m_slots);
+	m_slots.assign(old.size() * 2, 0);
+	for (uint64_t fingerprint : old) {
+		if (fingerprint != 0) {
+			m_slots[Find_Slot(fingerprint)] = fingerprint;
+		}
+	}
+}
+
+bool CFingerprintSet::Insert(std::string_view url) {
+	uint64_t fingerprint = Fingerprint(url);
+	m_lookups++;
+
+	bool bloomSaysMaybe = true;
+	if (m_bloomHashes > 0) {
+		bloomSaysMaybe = Bloom_Maybe_Contains(fingerprint);
+		if (!bloomSaysMaybe) {
+			m_bloomNegatives++;
+		}
+	}
+
+	size_t slot = Find_Slot(fingerprint);
+	if (m_slots[slot] == fingerprint) {
+		return false;
+	}
+	if (bloomSaysMaybe && m_bloomHashes > 0) {
+		m_bloomFalsePositives++;
+	}
+
+	m_slots[slot] = fingerprint;
+	m_size++;
+	if (m_bloomHashes > 0) {
+		Bloom_Add(fingerprint);
+	}
+
+	if (m_size * 100 > m_slots.size() * MaxLoadPercent) {
+		Grow();
+	}
+	return true;
+}
+
+bool CFingerprintSet::Contains(std::string_view url) const {
+	uint64_t fingerprint = Fingerprint(url);
+	m_lookups++;
+
+	// zaporna odpoved Bloomova filtru je jista, tabulku pak neni treba prohledavat
+	if (m_bloomHashes > 0 && !Bloom_Maybe_Contains(fingerprint)) {
+		m_bloomNegatives++;
+		return false;
+	}
+
+	bool found = m_slots[Find_Slot(fingerprint)] == fingerprint;
+	if (!found && m_bloomHashes > 0) {
+		m_bloomFalsePositives++;
+	}
+	return found;
+}
+
+size_t CFingerprintSet::Memory_Usage() const {
+	return m_slots.capacity() * sizeof(uint64_t) + m_bloomBits.capacity() * sizeof(uint64_t);
+}
+
+CFingerprintSet::Stats CFingerprintSet::Get_Stats() const {
+	Stats stats;
+	stats.size = m_size;
+	stats.lookups = m_lookups;
+	stats.bloomNegatives = m_bloomNegatives;
+	stats.bloomFalsePositives = m_bloomFalsePositives;
+	// narozeninovy paradox: P(kolize) ~ n^2 / 2^65
+	double n = static_cast<double>(m_size);
+	stats.expectedCollisionRate = std::min(1.0, n * n / std::ldexp(1.0, 65));
+	stats.memoryBytes = Memory_Usage();
+	return stats;
+}
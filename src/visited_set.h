@@ -0,0 +1,71 @@
+/**
+ * Kompaktni mnozina navstivenych URL - uklada jen 64bitove otisky URL, volitelne s Bloomovym filtrem pred tabulkou
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class CFingerprintSet {
+	public:
+		struct Config {
+			// predpokladany pocet URL - urcuje pocatecni velikost tabulky a velikost Bloomova filtru
+			size_t expectedUrls = 1 << 16;
+			// zapnout Bloomuv filtr pred tabulkou otisku
+			bool useBloomFilter = false;
+			// cilova pravdepodobnost falesne pozitivni odpovedi Bloomova filtru
+			double bloomFalsePositiveRate = 0.01;
+		};
+
+		struct Stats {
+			size_t size = 0;                   // pocet ulozenych otisku
+			size_t lookups = 0;                // pocet volani Insert/Contains
+			size_t bloomNegatives = 0;         // dotazy vyrizene jen Bloomovym filtrem (URL urcite nova)
+			size_t bloomFalsePositives = 0;    // filtr odpovedel "mozna", ale otisk v tabulce nebyl
+			double expectedCollisionRate = 0;  // pravdepodobnost, ze nektera nova URL byla spatne povazovana za navstivenou (kolize otisku)
+			size_t memoryBytes = 0;            // tabulka + Bloomuv filtr
+		};
+
+	private:
+		// otevrene adresovani; 0 oznacuje prazdny slot (otisk 0 se nahrazuje 1)
+		std::vector<uint64_t> m_slots;
+		size_t m_size{ 0 };
+
+		std::vector<uint64_t> m_bloomBits;
+		size_t m_bloomBitCount{ 0 };
+		unsigned m_bloomHashes{ 0 };
+
+		mutable size_t m_lookups{ 0 };
+		mutable size_t m_bloomNegatives{ 0 };
+		mutable size_t m_bloomFalsePositives{ 0 };
+
+		bool Bloom_Maybe_Contains(uint64_t fingerprint) const;
+		void Bloom_Add(uint64_t fingerprint);
+
+		// najde slot s otiskem nebo prvni prazdny slot
+		size_t Find_Slot(uint64_t fingerprint) const;
+		void Grow();
+
+	public:
+		explicit CFingerprintSet(const Config& config);
+		CFingerprintSet() : CFingerprintSet(Config{}) {}
+
+		// 64bitovy otisk URL
+		static uint64_t Fingerprint(std::string_view url);
+
+		// vlozi URL; vraci true, pokud v mnozine (podle otisku) jeste nebyla
+		bool Insert(std::string_view url);
+
+		bool Contains(std::string_view url) const;
+
+		size_t Size() const {
+			return m_size;
+		}
+
+		size_t Memory_Usage() const;
+
+		Stats Get_Stats() const;
+};
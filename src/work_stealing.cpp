@@ -0,0 +1,42 @@
+/**
+ * Struktury pro paralelni crawler ve sdilene pameti (bez MPI)
+ */
+
+#include "work_stealing.h"
+
+#include <functional>
+
+CConcurrentUrlSet::CConcurrentUrlSet(size_t shardCount) {
+	if (shardCount == 0) {
+		shardCount = 1;
+	}
+	m_shards.reserve(shardCount);
+	for (size_t i = 0; i < shardCount; i++) {
+		m_shards.push_back(std::make_unique<Shard>());
+	}
+}
+
+CConcurrentUrlSet::Shard& CConcurrentUrlSet::Shard_For(const std::string& url) {
+	return *m_shards[std::hash<std::string>{}(url) % m_shards.size()];
+}
+
+bool CConcurrentUrlSet::Insert(const std::string& url) {
+	Shard& shard = Shard_For(url);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	return shard.urls.insert(url).second;
+}
+
+bool CConcurrentUrlSet::Contains(const std::string& url) {
+	Shard& shard = Shard_For(url);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	return shard.urls.find(url) != shard.urls.end();
+}
+
+size_t CConcurrentUrlSet::Size() {
+	size_t size = 0;
+	for (auto& shard : m_shards) {
+		std::lock_guard<std::mutex> lock(shard->mutex);
+		size += shard->urls.size();
+	}
+	return size;
+}
@@ -0,0 +1,80 @@
+/**
+ * Struktury pro paralelni crawler ve sdilene pameti (bez MPI)
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <cstddef>
+
+// fronta ulohy jednoho vlakna; vlastnik pracuje se spodnim koncem (LIFO), ostatni vlakna kradou z horniho (FIFO)
+template<typename T>
+class WorkStealingDeque {
+	private:
+		std::deque<T> m_items;
+		mutable std::mutex m_mutex;
+
+	public:
+		void Push_Bottom(T item) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_items.push_back(std::move(item));
+		}
+
+		std::optional<T> Pop_Bottom() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_items.empty()) {
+				return std::nullopt;
+			}
+			T item = std::move(m_items.back());
+			m_items.pop_back();
+			return item;
+		}
+
+		std::optional<T> Steal_Top() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_items.empty()) {
+				return std::nullopt;
+			}
+			T item = std::move(m_items.front());
+			m_items.pop_front();
+			return item;
+		}
+
+		size_t Size() const {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_items.size();
+		}
+};
+
+// mnozina navstivenych URL rozdelena na nezavisle zamykane casti podle hashe
+class CConcurrentUrlSet {
+	public:
+		// vychozi pocet casti; vice casti = mene soupereni o zamky
+		static constexpr size_t DefaultShardCount = 64;
+
+	private:
+		struct Shard {
+			std::mutex mutex;
+			std::unordered_set<std::string> urls;
+		};
+
+		std::vector<std::unique_ptr<Shard>> m_shards;
+
+		Shard& Shard_For(const std::string& url);
+
+	public:
+		explicit CConcurrentUrlSet(size_t shardCount = DefaultShardCount);
+
+		// vlozi URL; vraci true, pokud v mnozine jeste nebyla
+		bool Insert(const std::string& url);
+
+		bool Contains(const std::string& url);
+
+		size_t Size();
+};
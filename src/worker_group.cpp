@@ -0,0 +1,82 @@
+/**
+ * Skupina Worker B, kterym Worker A posila URL ke stazeni a od kterych prijima vysledky
+ */
+
+#include "worker_group.h"
+#include "mpi_protocol.h"
+
+#include <algorithm>
+
+CWorkerBGroup::CWorkerBGroup(std::vector<int> workers, size_t prefetchDepth)
+	: m_workers{ std::move(workers) }, m_prefetchDepth{ prefetchDepth > 0 ? prefetchDepth : 1 } {
+	m_tasks.resize(m_workers.size());
+}
+
+size_t CWorkerBGroup::Least_Loaded() const {
+	size_t best = 0;
+	for (size_t i = 1; i < m_tasks.size(); i++) {
+		if (m_tasks[i].size() < m_tasks[best].size()) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+bool CWorkerBGroup::Can_Assign() const {
+	return !m_workers.empty() && m_tasks[Least_Loaded()].size() < m_prefetchDepth;
+}
+
+int CWorkerBGroup::Assign(std::string url) {
+	size_t index = Least_Loaded();
+	int workerB = m_workers[index];
+
+	// jedna zprava bez ukonceni nulou, delku Worker B zjisti z MPI_Get_count
+	auto& task = m_tasks[index].emplace_back(PendingTask{ std::move(url), MPI_REQUEST_NULL });
+	MPI_Isend(task.url.data(), static_cast<int>(task.url.length()), MPI_CHAR, workerB, URL_TASK, MPI_COMM_WORLD, &task.request);
+	m_inFlight++;
+
+	return workerB;
+}
+
+void CWorkerBGroup::Receive_Grant(MPI_Status& probed) {
+	int count;
+	MPI_Get_count(&probed, MPI_INT, &count);
+	std::vector<int> granted(count);
+	MPI_Recv(granted.data(), count, MPI_INT, probed.MPI_SOURCE, WORKER_GRANT, MPI_COMM_WORLD, &probed);
+
+	m_workers.insert(m_workers.end(), granted.begin(), granted.end());
+	m_tasks.resize(m_workers.size());
+}
+
+std::vector<char> CWorkerBGroup::Receive_Message(MPI_Status& probed) {
+	int workerB = probed.MPI_SOURCE;
+	int messageSize;
+	MPI_Get_count(&probed, MPI_CHAR, &messageSize);
+
+	std::vector<char> message = m_messagePool.Acquire(messageSize);
+	MPI_Recv(message.data(), messageSize, MPI_CHAR, workerB, PAGE_RESULT, MPI_COMM_WORLD, &probed);
+
+	// zpravy mezi dvema procesy se nepredbihaji - vysledek patri k nejstarsi uloze tohoto Worker B
+	size_t index = std::find(m_workers.begin(), m_workers.end(), workerB) - m_workers.begin();
+	auto& tasks = m_tasks[index];
+	MPI_Wait(&tasks.front().request, MPI_STATUS_IGNORE);
+	tasks.pop_front();
+	m_inFlight--;
+
+	return message;
+}
+
+bool CWorkerBGroup::Receive_Result(MPI_Status& probed, PageAnalysisResult& result) {
+	std::vector<char> message = Receive_Message(probed);
+	bool decoded = decodePage(message.data(), message.size(), result);
+	m_messagePool.Release(std::move(message));
+	return decoded;
+}
+
+void CWorkerBGroup::Drain() {
+	while (m_inFlight > 0) {
+		MPI_Status probed;
+		MPI_Probe(MPI_ANY_SOURCE, PAGE_RESULT, MPI_COMM_WORLD, &probed);
+		m_messagePool.Release(Receive_Message(probed));
+	}
+}
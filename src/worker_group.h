@@ -0,0 +1,65 @@
+/**
+ * Skupina Worker B, kterym Worker A posila URL ke stazeni a od kterych prijima vysledky
+ */
+
+#pragma once
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstddef>
+
+#include "page_analysis.h"
+#include "page_message.h"
+
+class CWorkerBGroup {
+	private:
+		// odeslane URL, na ktere Worker B jeste nevratil vysledek; MPI_Isend ukazuje primo do url
+		struct PendingTask {
+			std::string url;
+			MPI_Request request;
+		};
+
+		std::vector<int> m_workers;
+		// ulohy kazdeho Worker B v poradi odeslani (stejny index jako m_workers); std::deque nepresouva prvky pri push_back
+		std::vector<std::deque<PendingTask>> m_tasks;
+		size_t m_prefetchDepth;
+		int m_inFlight{ 0 };
+		CMessageBufferPool m_messagePool;
+
+		// index Worker B s nejkratsi frontou uloh
+		size_t Least_Loaded() const;
+
+		// prijme zpravu PAGE_RESULT zjistenou pres MPI_Probe a uvolni nejstarsi ulohu odesilatele
+		std::vector<char> Receive_Message(MPI_Status& probed);
+
+	public:
+		// prefetchDepth - kolik URL muze mit kazdy Worker B odeslanych dopredu
+		CWorkerBGroup(std::vector<int> workers, size_t prefetchDepth);
+
+		size_t Size() const { return m_workers.size(); }
+
+		// pocet odeslanych URL bez vysledku
+		int In_Flight() const { return m_inFlight; }
+
+		// ma nektery Worker B misto pro dalsi URL
+		bool Can_Assign() const;
+
+		// posle URL Worker B s nejkratsi frontou (MPI_Isend) a vrati jeho rank; predpoklada Can_Assign()
+		int Assign(std::string url);
+
+		// prijme seznam pujcenych Worker B od mastra (zprava WORKER_GRANT zjistena pres MPI_Probe)
+		void Receive_Grant(MPI_Status& probed);
+
+		// prijme a dekoduje vysledek (zprava PAGE_RESULT zjistena pres MPI_Probe);
+		// vraci false, pokud byla zprava poskozena (uloha se presto uvolni)
+		bool Receive_Result(MPI_Status& probed, PageAnalysisResult& result);
+
+		// prijme a zahodi vysledky vsech rozpracovanych URL, aby nezustaly ve fronte zprav
+		void Drain();
+
+		// kolikrat musel zasobnik zvetsit nebo vytvorit prijimaci buffer
+		size_t Buffer_Allocations() const { return m_messagePool.Allocations(); }
+};
@@ -0,0 +1,41 @@
+/**
+ * Prevod binarniho grafu odkazu (graph.bin) zpet do textoveho formatu map.txt
+ *
+ * Pouziti: graph_to_map <graph.bin> [map.txt]   (bez druheho argumentu vypisuje na standardni vystup)
+ */
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+#include "../src/link_graph.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <graph.bin> [map.txt]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CLinkGraphView graph;
+    std::string error;
+    if (!graph.Open(argv[1], error)) {
+        std::cerr << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << graph.Node_Count() << " nodes, " << graph.Edge_Count() << " distinct edges" << std::endl;
+
+    if (argc == 3) {
+        std::ofstream out(argv[2]);
+        if (!out) {
+            std::cerr << "Nelze vytvorit soubor: " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+        writeMapText(graph, out);
+        return out ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    writeMapText(graph, std::cout);
+    return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,224 @@
+#!/bin/bash
+# Zatezovy test obchazeni proti syntetickemu webu na localhostu (tools/synthetic_site.cpp).
+#
+# Prelozi synteticky web a pro kazdy rezim variantu crawleru (main.cpp s -DUPP_CRAWL_MODE, MPI s -DUPP_PARALLEL=1).
+# Kazdou variantu spusti v cistem adresari (MPI pres mpirun --oversubscribe na lokalnich procesech), zada job
+# POST /jobs se vstupnimi URL webu a pocka na jeho dokonceni. Nakonec vypise pro kazdy rezim stranky/s, celkovy cas,
+# pozadavky na web a casy jednotlivych fazi z vystupu crawleru; souhrn ulozi do <adresar>/summary.txt.
+#
+# Pouziti: tools/load_test.sh [-m rezimy] [-w pocet webu] [-n Worker A] [-b Worker B] [-i] [-p port] [-t limit s] [-o adresar]
+#                             [-- parametry synthetic_site]
+#   -m  rezimy oddelene carkou: serial,pipelined,workstealing,mpi (vychozi vsechny)
+#   -w  pocet webu = vstupnich URL jobu, kazdy web je jina domena (vychozi 2)
+#   -n  pocet Worker A, -b pocet Worker B na jeden Worker A v MPI verzi (vychozi 2 a 2)
+#   -i  bez rizeni zateze hostitelu (-DUPP_POLITE_CRAWLING=0) - jinak CHostScheduler omezi rychlost kazdeho webu
+#   -p  port syntetickeho webu (vychozi 8080); crawler vzdy posloucha na 8001 (main.cpp)
+#   -t  nejdelsi doba jobu v sekundach (vychozi 600)
+#   -o  pracovni adresar (vychozi /tmp/upp_load_test)
+# Priklad: tools/load_test.sh -m serial,mpi -i -- --pages 500 --fanout 8 --latency-ms 20 --error-rate 0.02 --duplicate-rate 0.1
+#
+# MPI verze (DomainPerWorkerA) obchazi z kazdeho webu nejvyse 100 stranek - rezimy porovnavejte podle stranek/s.
+
+set -u
+
+REPO="$(cd "$(dirname "$0")/.." && pwd)"
+MODES="serial,pipelined,workstealing,mpi"
+SITES=2
+WORKERS_A=2
+WORKERS_B=2
+POLITE=1
+SITE_PORT=8080
+CRAWLER_URL="http://localhost:8001"
+TIMEOUT=600
+WORK=/tmp/upp_load_test
+
+while getopts "m:w:n:b:ip:t:o:" option; do
+    case $option in
+        m) MODES=$OPTARG ;;
+        w) SITES=$OPTARG ;;
+        n) WORKERS_A=$OPTARG ;;
+        b) WORKERS_B=$OPTARG ;;
+        i) POLITE=0 ;;
+        p) SITE_PORT=$OPTARG ;;
+        t) TIMEOUT=$OPTARG ;;
+        o) WORK=$OPTARG ;;
+        *) sed -n '9,20p' "$0"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+SITE_ARGS=("$@")
+
+SITE_URL="http://127.0.0.1:$SITE_PORT"
+CXX=${CXX:-mpic++}
+CXXFLAGS=(-std=c++20 -O2 -pthread -I"$REPO/dep/cpp-httplib")
+
+MPIRUN_FLAGS=()
+if mpirun --version 2>&1 | grep -q "Open MPI"; then
+    MPIRUN_FLAGS+=(--oversubscribe)
+    if [ "$(id -u)" = 0 ]; then
+        MPIRUN_FLAGS+=(--allow-run-as-root)
+    fi
+fi
+
+SITE_PID=""
+CRAWLER_PID=""
+
+cleanup() {
+    if [ -n "$CRAWLER_PID" ]; then
+        kill "$CRAWLER_PID" 2>/dev/null
+        wait "$CRAWLER_PID" 2>/dev/null
+    fi
+    if [ -n "$SITE_PID" ]; then
+        kill "$SITE_PID" 2>/dev/null
+        wait "$SITE_PID" 2>/dev/null
+    fi
+}
+trap cleanup EXIT
+
+# ceka, az adresa odpovi (nejvyse 30 s)
+waitFor() {
+    for _ in $(seq 300); do
+        if curl -s -o /dev/null "$1"; then
+            return 0
+        fi
+        sleep 0.1
+    done
+    return 1
+}
+
+# hodnota pole z jednoradkoveho JSON (cislo nebo retezec bez uvozovek)
+jsonField() {
+    sed -n "s/.*\"$2\":\"\{0,1\}\([^,\"}]*\).*/\1/p" <<< "$1"
+}
+
+# rozdil pole /stats syntetickeho webu pred a po behu
+statsDelta() {
+    echo $(( $(jsonField "$2" "$3") - $(jsonField "$1" "$3") ))
+}
+
+build() {
+    local output=$1
+    shift
+    echo "Preklad $output $*"
+    $CXX "${CXXFLAGS[@]}" "$@" "$REPO"/src/*.cpp -o "$WORK/$output" || exit 1
+}
+
+# casy fazi z vystupu crawleru
+printStages() {
+    local mode=$1 log=$2
+    if [ "$mode" = mpi ]; then
+        grep -E "^Master: Processed URL" "$log"
+        grep -E "^Worker A [0-9]+: (Crawled|Reported|Hostitel)" "$log"
+        # Worker B: "Processed N pages, waited X ms for tasks"
+        awk '/^Worker B [0-9]+: Processed [0-9]+ pages, waited/ { pages += $5; waited += $8; workers++ }
+             END { if (workers > 0) printf "Worker B: %d stranek, cekani na ulohy %d ms celkem, %.0f ms prumerne na Worker B (%d)\n", pages, waited, waited / workers, workers }' "$log"
+    else
+        grep -E "^(Celkový čas provedení|Průměrná doba provedení operace analýzy|Průměrný čas pro provedení operace načtení|Souběh stahování a analýzy|Analýza překrytá|Výsledky:|Pool spojení|DNS cache|Hostitel )" "$log"
+    fi
+}
+
+runMode() {
+    local mode=$1
+    local defines=()
+    case $mode in
+        serial) defines=(-DUPP_CRAWL_MODE=Serial) ;;
+        pipelined) defines=(-DUPP_CRAWL_MODE=Pipelined) ;;
+        workstealing) defines=(-DUPP_CRAWL_MODE=WorkStealing) ;;
+        mpi) defines=(-DUPP_PARALLEL=1) ;;
+        *) echo "Neznamy rezim $mode"; return 1 ;;
+    esac
+    if [ "$POLITE" = 0 ]; then
+        defines+=(-DUPP_POLITE_CRAWLING=0)
+    fi
+    build "upp2_$mode" "${defines[@]}"
+
+    # CServer cte ../data; results/ vcetne cache podmineneho GET je pro kazdy beh nova
+    local dir="$WORK/$mode"
+    rm -rf "$dir"
+    mkdir -p "$dir/run"
+    ln -s "$REPO/data" "$dir/data"
+    if [ "$mode" = mpi ]; then
+        local processes=$((1 + WORKERS_A + WORKERS_A * WORKERS_B))
+        (cd "$dir/run" && exec mpirun "${MPIRUN_FLAGS[@]}" -np "$processes" "$WORK/upp2_$mode" -n "$WORKERS_A" -m "$WORKERS_B") > "$dir/crawler.log" 2>&1 &
+    else
+        (cd "$dir/run" && exec "$WORK/upp2_$mode") > "$dir/crawler.log" 2>&1 &
+    fi
+    CRAWLER_PID=$!
+    if ! waitFor "$CRAWLER_URL/"; then
+        echo "$mode: crawler neodpovida, viz $dir/crawler.log"
+        return 1
+    fi
+
+    local urls=""
+    for site in $(seq "$SITES"); do
+        urls+="$SITE_URL/site$site/p/0.html"$'\n'
+    done
+
+    local before after job id state start end
+    before=$(curl -s "$SITE_URL/stats")
+    start=$(date +%s.%N)
+    job=$(curl -s -X POST -H "Content-Type: text/plain" --data-binary "$urls" "$CRAWLER_URL/jobs")
+    id=$(jsonField "$job" id)
+    if [ -z "$id" ]; then
+        echo "$mode: job nebyl prijat: $job"
+        return 1
+    fi
+    while true; do
+        job=$(curl -s "$CRAWLER_URL/jobs/$id")
+        state=$(jsonField "$job" state)
+        if [ "$state" = done ] || [ "$state" = failed ]; then
+            break
+        fi
+        if [ "$(awk "BEGIN { print ($(date +%s.%N) - $start > $TIMEOUT) }")" = 1 ]; then
+            state=timeout
+            break
+        fi
+        sleep 0.2
+    done
+    end=$(date +%s.%N)
+    after=$(curl -s "$SITE_URL/stats")
+
+    kill "$CRAWLER_PID" 2>/dev/null
+    wait "$CRAWLER_PID" 2>/dev/null
+    CRAWLER_PID=""
+
+    local pages wall
+    pages=$(jsonField "$job" pagesDone)
+    wall=$(awk "BEGIN { printf \"%.2f\", $end - $start }")
+    printf "%-14s %-8s %8s %10s %10s %10s %8s %10s %10s\n" "$mode" "$state" "$pages" "$wall" \
+        "$(awk "BEGIN { printf \"%.1f\", ${pages:-0} / ($wall > 0 ? $wall : 1) }")" \
+        "$(statsDelta "$before" "$after" requests)" "$(statsDelta "$before" "$after" errors)" \
+        "$(statsDelta "$before" "$after" redirects)" \
+        "$(awk "BEGIN { printf \"%.1f\", $(statsDelta "$before" "$after" bytes) / 1e6 }")" >> "$WORK/rows.txt"
+    {
+        echo "== $mode"
+        printStages "$mode" "$dir/crawler.log"
+        echo
+    } >> "$WORK/stages.txt"
+}
+
+mkdir -p "$WORK"
+rm -f "$WORK/rows.txt" "$WORK/stages.txt"
+
+echo "Preklad synthetic_site"
+$CXX "${CXXFLAGS[@]}" "$REPO/tools/synthetic_site.cpp" -o "$WORK/synthetic_site" || exit 1
+"$WORK/synthetic_site" --port "$SITE_PORT" "${SITE_ARGS[@]}" > "$WORK/synthetic_site.log" 2>&1 &
+SITE_PID=$!
+if ! waitFor "$SITE_URL/stats"; then
+    echo "Synteticky web neodpovida, viz $WORK/synthetic_site.log"
+    exit 1
+fi
+head -1 "$WORK/synthetic_site.log"
+
+for mode in ${MODES//,/ }; do
+    echo "Beh $mode ..."
+    runMode "$mode"
+done
+
+{
+    echo "Synteticky web: ${SITE_ARGS[*]:-vychozi parametry}; webu $SITES, rizeni zateze $POLITE, MPI -n $WORKERS_A -m $WORKERS_B"
+    printf "%-14s %-8s %8s %10s %10s %10s %8s %10s %10s\n" "rezim" "stav" "stranky" "cas [s]" "stranky/s" "pozadavky" "chyby" "presmer." "MB"
+    cat "$WORK/rows.txt" 2>/dev/null
+    echo
+    cat "$WORK/stages.txt" 2>/dev/null
+} | tee "$WORK/summary.txt"
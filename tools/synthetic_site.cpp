@@ -0,0 +1,333 @@
+/**
+ * Synteticky web pro opakovatelne mereni obchazeni (tools/load_test.sh) - HTTP server na localhostu (httplib::Server
+ * jako CServer), ktery generuje stranky podle parametru misto obchazeni skutecnych webu.
+ *
+ * Kazdy prvni segment cesty je samostatny web (/<web>/...), takze jeden server obslouzi vice domen MPI verze.
+ * Stranky webu tvori strom: stranka i odkazuje na sve potomky i * fanout + 1 .. i * fanout + fanout (jen do poctu
+ * stranek a do hloubky depth), navic na korenovou a nadrazenou stranku.
+ *
+ *   /<web>/p/<i>.html            stranka i; dotaz (?sid=...) se ignoruje - odkaz s nim je presna duplicita
+ *   /<web>/r/<k>/<i>.html        retez presmerovani delky k (301) na /<web>/p/<i>.html
+ *   /robots.txt                  volitelne s Crawl-delay
+ *   /stats                       citace pozadavku (JSON)
+ *
+ * Volba odkazu na presmerovani a duplicit je deterministicka (podle seed), takze kazdy beh vidi stejny web.
+ * Zpozdeni a chyby se losuji pri kazdem pozadavku - opakovani stejne stranky muze uspet.
+ *
+ * Pouziti: synthetic_site [--port 8080] [--address 127.0.0.1] [--pages 1000] [--fanout 10] [--depth 0]
+ *                         [--page-size 16384] [--duplicate-rate 0] [--redirect-rate 0] [--redirect-chain 2]
+ *                         [--latency-ms 0] [--jitter-ms 0] [--error-rate 0] [--error-status 503]
+ *                         [--crawl-delay 0] [--threads 64] [--seed 1]
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+#include <httplib.h>
+
+namespace {
+    struct SiteConfig {
+        std::string address = "127.0.0.1";
+        int port = 8080;
+        // stranek v kazdem webu
+        size_t pages = 1000;
+        // odkazu na potomky na strance
+        size_t fanout = 10;
+        // nejvetsi hloubka stromu (koren = 0); 0 = omezuje jen pocet stranek
+        size_t depth = 0;
+        // priblizna velikost HTML stranky v bajtech
+        size_t pageSize = 16384;
+        // podil odkazu na potomka, ke kterym je navic odkaz s ?sid= (stejny obsah pod jinou URL)
+        double duplicateRate = 0;
+        // podil odkazu na potomka vedoucich pres retez presmerovani delky redirectChain
+        double redirectRate = 0;
+        size_t redirectChain = 2;
+        // zpozdeni kazde odpovedi: latencyMs + nahodne 0 .. jitterMs
+        int latencyMs = 0;
+        int jitterMs = 0;
+        // podil pozadavku na stranky, ktere skonci chybou errorStatus
+        double errorRate = 0;
+        int errorStatus = 503;
+        // Crawl-delay v robots.txt v sekundach; 0 = bez Crawl-delay
+        double crawlDelay = 0;
+        // vlaken serveru - kazde zpozdena odpoved jedno blokuje
+        size_t threads = 64;
+        uint64_t seed = 1;
+    };
+
+    struct SiteStats {
+        std::atomic<uint64_t> requests{ 0 };
+        std::atomic<uint64_t> pages{ 0 };
+        std::atomic<uint64_t> duplicates{ 0 };
+        std::atomic<uint64_t> redirects{ 0 };
+        std::atomic<uint64_t> errors{ 0 };
+        std::atomic<uint64_t> notFound{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+    };
+
+    constexpr const char* Words[] = {
+        "crawler", "page", "link", "graph", "queue", "worker", "thread", "domain", "header", "content",
+        "server", "client", "socket", "buffer", "stream", "parser", "token", "index", "cache", "frontier",
+        "latency", "throughput", "batch", "message", "result", "archive", "scheduler", "host", "robots", "delay",
+        "network", "request", "response", "status", "redirect", "duplicate", "hash", "vector", "table", "string",
+        "memory", "arena", "chunk", "offset", "record", "writer", "reader", "format", "output", "input",
+        "master", "rank", "process", "signal", "timer", "stage", "pipeline", "steal", "deque", "atomic",
+        "mutex", "lock", "future", "promise"
+    };
+
+    // splitmix64 - deterministicke "nahodne" hodnoty z klice bez sdileneho stavu generatoru
+    uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // hodnota z [0, 1) pro klic
+    double unit(uint64_t key) {
+        return static_cast<double>(mix(key) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    size_t depthOf(size_t page, size_t fanout) {
+        size_t depth = 0;
+        while (page != 0) {
+            page = (page - 1) / fanout;
+            depth++;
+        }
+        return depth;
+    }
+
+    class CSyntheticSite {
+        private:
+            SiteConfig m_config;
+            SiteStats m_stats;
+            // poradi pozadavku - klic pro losovani zpozdeni a chyb
+            std::atomic<uint64_t> m_requestCounter{ 0 };
+
+            bool Page_Exists(size_t page) const {
+                return page < m_config.pages && (m_config.depth == 0 || depthOf(page, m_config.fanout) <= m_config.depth);
+            }
+
+            // vylosuje zpozdeni pozadavku a pocka; vraci true, pokud ma pozadavek skoncit chybou
+            bool Delay_And_Fail(bool canFail) {
+                uint64_t key = mix(m_config.seed ^ m_requestCounter.fetch_add(1, std::memory_order_relaxed));
+                int delayMs = m_config.latencyMs + (m_config.jitterMs > 0 ? static_cast<int>(unit(key) * (m_config.jitterMs + 1)) : 0);
+                if (delayMs > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+                }
+                return canFail && unit(key + 1) < m_config.errorRate;
+            }
+
+            std::string Render_Page(const std::string& site, size_t page) const {
+                std::string prefix = "/" + site;
+                std::string html;
+                html.reserve(m_config.pageSize + 4096);
+                html += "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>" + site + " " + std::to_string(page) + "</title>\n</head>\n<body>\n";
+                html += "<nav><a href=\"" + prefix + "/p/0.html\">Home</a>";
+                if (page != 0) {
+                    html += " <a href=\"" + prefix + "/p/" + std::to_string((page - 1) / m_config.fanout) + ".html\">Up</a>";
+                }
+                html += "</nav>\n<h1>Page " + std::to_string(page) + "</h1>\n<ul>\n";
+
+                for (size_t k = 1; k <= m_config.fanout; k++) {
+                    size_t child = page * m_config.fanout + k;
+                    if (!Page_Exists(child)) {
+                        break;
+                    }
+                    uint64_t key = mix(m_config.seed ^ mix(child));
+                    std::string target = unit(key) < m_config.redirectRate && m_config.redirectChain > 0
+                        ? prefix + "/r/" + std::to_string(m_config.redirectChain) + "/" + std::to_string(child) + ".html"
+                        : prefix + "/p/" + std::to_string(child) + ".html";
+                    html += "<li><a href=\"" + target + "\">Page " + std::to_string(child) + "</a>";
+                    if (unit(key + 1) < m_config.duplicateRate) {
+                        html += " <a href=\"" + prefix + "/p/" + std::to_string(child) + ".html?sid=" + std::to_string(page) + "\">(session)</a>";
+                    }
+                    html += "</li>\n";
+                }
+                html += "</ul>\n";
+
+                for (size_t i = 0; i < page % 4; i++) {
+                    html += "<img src=\"" + prefix + "/img/" + std::to_string(page) + "_" + std::to_string(i) + ".png\" alt=\"\">\n";
+                }
+                if (page % 10 == 0) {
+                    html += "<form action=\"" + prefix + "/search\"><input name=\"q\"></form>\n";
+                }
+
+                // text stranky z nahodnych slov (ruzne stranky nejsou podobne pro SimHash), nadpis po ~1 KB
+                uint64_t state = mix(m_config.seed ^ mix(page + 0x5bd1e995ULL));
+                for (size_t section = 0; html.size() < m_config.pageSize; section++) {
+                    html += "<h2>Section " + std::to_string(section + 1) + "</h2>\n<p>";
+                    size_t sectionEnd = html.size() + 1024;
+                    while (html.size() < sectionEnd && html.size() < m_config.pageSize) {
+                        state = mix(state);
+                        html += Words[state % std::size(Words)];
+                        html += ' ';
+                    }
+                    html += "</p>\n";
+                }
+                html += "</body>\n</html>\n";
+                return html;
+            }
+
+            void Handle_Page(const httplib::Request& req, httplib::Response& res) {
+                m_stats.requests++;
+                size_t page = std::strtoull(req.matches[2].str().c_str(), nullptr, 10);
+                if (Delay_And_Fail(true)) {
+                    m_stats.errors++;
+                    res.status = m_config.errorStatus;
+                    res.set_content("Injected error", "text/plain");
+                    return;
+                }
+                if (!Page_Exists(page)) {
+                    m_stats.notFound++;
+                    res.status = 404;
+                    res.set_content("Not found", "text/plain");
+                    return;
+                }
+                if (req.has_param("sid")) {
+                    m_stats.duplicates++;
+                }
+                m_stats.pages++;
+                std::string html = Render_Page(req.matches[1].str(), page);
+                m_stats.bytes += html.size();
+                res.set_content(html, "text/html; charset=utf-8");
+            }
+
+            void Handle_Redirect(const httplib::Request& req, httplib::Response& res) {
+                m_stats.requests++;
+                m_stats.redirects++;
+                Delay_And_Fail(false);
+                std::string site = req.matches[1].str();
+                size_t remaining = std::strtoull(req.matches[2].str().c_str(), nullptr, 10);
+                std::string page = req.matches[3].str();
+                res.set_redirect(remaining > 1
+                    ? "/" + site + "/r/" + std::to_string(remaining - 1) + "/" + page + ".html"
+                    : "/" + site + "/p/" + page + ".html", 301);
+            }
+
+            void Handle_Robots(const httplib::Request&, httplib::Response& res) {
+                m_stats.requests++;
+                std::ostringstream robots;
+                robots << "User-agent: *\n";
+                if (m_config.crawlDelay > 0) {
+                    robots << "Crawl-delay: " << m_config.crawlDelay << "\n";
+                }
+                robots << "Disallow:\n";
+                res.set_content(robots.str(), "text/plain");
+            }
+
+            void Handle_Stats(const httplib::Request&, httplib::Response& res) {
+                std::ostringstream json;
+                json << "{\"requests\":" << m_stats.requests.load() << ",\"pages\":" << m_stats.pages.load()
+                     << ",\"duplicates\":" << m_stats.duplicates.load() << ",\"redirects\":" << m_stats.redirects.load()
+                     << ",\"errors\":" << m_stats.errors.load() << ",\"notFound\":" << m_stats.notFound.load()
+                     << ",\"bytes\":" << m_stats.bytes.load() << "}";
+                res.set_content(json.str(), "application/json");
+            }
+
+        public:
+            explicit CSyntheticSite(const SiteConfig& config) : m_config{ config } {
+            }
+
+            bool Run() {
+                httplib::Server server;
+                size_t threads = m_config.threads;
+                server.new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+
+                server.Get(R"(/([^/]+)/p/(\d+)\.html)", [this](const httplib::Request& req, httplib::Response& res) { Handle_Page(req, res); });
+                server.Get(R"(/([^/]+)/r/(\d+)/(\d+)\.html)", [this](const httplib::Request& req, httplib::Response& res) { Handle_Redirect(req, res); });
+                server.Get("/robots.txt", [this](const httplib::Request& req, httplib::Response& res) { Handle_Robots(req, res); });
+                server.Get("/stats", [this](const httplib::Request& req, httplib::Response& res) { Handle_Stats(req, res); });
+                // vola se pro kazdou odpoved >= 400; neznama cesta ma prazdne telo
+                server.set_error_handler([this](const httplib::Request&, httplib::Response& res) {
+                    if (res.status == 404 && res.body.empty()) {
+                        m_stats.requests++;
+                        m_stats.notFound++;
+                        res.set_content("Not found", "text/plain");
+                    }
+                });
+
+                std::cout << "Synteticky web na http://" << m_config.address << ":" << m_config.port << "/<web>/p/0.html: "
+                          << m_config.pages << " stranek, fanout " << m_config.fanout << ", hloubka " << m_config.depth
+                          << ", " << m_config.pageSize << " B na stranku" << std::endl;
+                return server.listen(m_config.address, m_config.port);
+            }
+    };
+
+    bool parseArguments(int argc, char** argv, SiteConfig& config) {
+        for (int i = 1; i < argc; i += 2) {
+            std::string name = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Chybi hodnota parametru " << name << std::endl;
+                return false;
+            }
+            std::string value = argv[i + 1];
+            if (name == "--address") {
+                config.address = value;
+            } else if (name == "--port") {
+                config.port = std::atoi(value.c_str());
+            } else if (name == "--pages") {
+                config.pages = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (name == "--fanout") {
+                config.fanout = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            } else if (name == "--depth") {
+                config.depth = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (name == "--page-size") {
+                config.pageSize = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (name == "--duplicate-rate") {
+                config.duplicateRate = std::atof(value.c_str());
+            } else if (name == "--redirect-rate") {
+                config.redirectRate = std::atof(value.c_str());
+            } else if (name == "--redirect-chain") {
+                config.redirectChain = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (name == "--latency-ms") {
+                config.latencyMs = std::atoi(value.c_str());
+            } else if (name == "--jitter-ms") {
+                config.jitterMs = std::atoi(value.c_str());
+            } else if (name == "--error-rate") {
+                config.errorRate = std::atof(value.c_str());
+            } else if (name == "--error-status") {
+                config.errorStatus = std::atoi(value.c_str());
+            } else if (name == "--crawl-delay") {
+                config.crawlDelay = std::atof(value.c_str());
+            } else if (name == "--threads") {
+                config.threads = std::max<size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            } else if (name == "--seed") {
+                config.seed = std::strtoull(value.c_str(), nullptr, 10);
+            } else {
+                std::cerr << "Neznamy parametr " << name << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    SiteConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        std::cerr << "Usage: " << argv[0] << " [--port N] [--address A] [--pages N] [--fanout N] [--depth N] [--page-size B]"
+                  << " [--duplicate-rate R] [--redirect-rate R] [--redirect-chain N] [--latency-ms N] [--jitter-ms N]"
+                  << " [--error-rate R] [--error-status S] [--crawl-delay S] [--threads N] [--seed N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CSyntheticSite site(config);
+    if (!site.Run()) {
+        std::cerr << "Nelze spustit server na " << config.address << ":" << config.port << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}